@@ -0,0 +1,133 @@
+#include "audit-log.h"
+
+#include "ns3/abort.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace ns3 {
+
+AuditLog::AuditLog(const std::string& filename, size_t capacity)
+    : m_file(std::fopen(filename.c_str(), "wb")),
+      m_cachedTail(0),
+      m_stalls(0),
+      m_head(0),
+      m_tail(0),
+      m_closing(false),
+      m_failed(0)
+{
+    NS_ABORT_MSG_IF(m_file == nullptr, "Cannot open audit file " << filename);
+    // writer가 이미 큰 연속 구간 단위로 쓰므로 stdio 버퍼 없이 써서 fwrite의 반환값이 실제 기록을 반영하게 함
+    std::setvbuf(m_file, nullptr, _IONBF, 0);
+
+    size_t size = 1;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    m_ring.resize(size);
+    m_mask = size - 1;
+
+    AuditFileHeader header = MakeAuditFileHeader();
+    NS_ABORT_MSG_IF(std::fwrite(&header, sizeof(header), 1, m_file) != 1,
+                    "Cannot write the header of audit file " << filename);
+
+    m_writer = std::thread(&AuditLog::WriterLoop, this);
+}
+
+AuditLog::~AuditLog()
+{
+    Close();
+}
+
+void AuditLog::Write(uint32_t flowId, const TcpDoAuditRecord& record)
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_cachedTail > m_mask)
+    {
+        // 캐시된 tail로 가득 찬 것처럼 보일 때만 writer의 진행 상황을 다시 읽음
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        while (head - m_cachedTail > m_mask)
+        {
+            ++m_stalls;
+            std::this_thread::yield();
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+        }
+    }
+
+    TcpDoAuditRecord& slot = m_ring[head & m_mask];
+    slot = record;
+    slot.flowId = flowId;
+    m_head.store(head + 1, std::memory_order_release);
+}
+
+void AuditLog::Close()
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    m_closing.store(true, std::memory_order_release);
+    m_writer.join();
+
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+uint64_t AuditLog::GetRecordCount() const
+{
+    return m_head.load(std::memory_order_relaxed);
+}
+
+uint64_t AuditLog::GetStallCount() const
+{
+    return m_stalls;
+}
+
+uint64_t AuditLog::GetFailedCount() const
+{
+    return m_failed.load(std::memory_order_relaxed);
+}
+
+void AuditLog::WriterLoop()
+{
+    uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        if (head == tail)
+        {
+            if (m_closing.load(std::memory_order_acquire))
+            {
+                // Close() 이전에 발행된 레코드가 남아 있는지 다시 확인
+                if (m_head.load(std::memory_order_acquire) == tail)
+                {
+                    break;
+                }
+                continue;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        // 링의 끝에서 끊어지지 않는 연속 구간 단위로 기록
+        uint64_t start = tail & m_mask;
+        uint64_t count = std::min(head - tail, m_mask + 1 - start);
+        // 기록하지 못한 레코드는 버리고 개수만 셈 (생산자가 멈추지 않도록 tail은 진행)
+        size_t written = std::fwrite(&m_ring[start], sizeof(TcpDoAuditRecord), count, m_file);
+        if (written < count)
+        {
+            m_failed.fetch_add(count - written, std::memory_order_relaxed);
+        }
+        tail += count;
+        m_tail.store(tail, std::memory_order_release);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,102 @@
+#ifndef AUDIT_LOG_H
+#define AUDIT_LOG_H
+
+#include "audit-record.h"
+
+#include "ns3/simple-ref-count.h"
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Binary sink for the TcpDo decision audit stream.
+ *
+ * The simulation thread is the only producer: Write() copies the record
+ * into a fixed ring and publishes it with a single release store, without
+ * locks, allocations or syscalls.  A background thread drains the ring to
+ * disk in contiguous chunks and polls every millisecond while it is empty.
+ * If the ring is full the producer yields until the writer catches up
+ * instead of dropping records; GetStallCount() reports how often that
+ * happened.  Records the writer fails to write, e.g. on a full disk, are
+ * lost and counted by GetFailedCount().
+ *
+ * The target of under 5% of simulation wall time with the log enabled was
+ * only measured in a detector-only loop built against stub ns-3 headers
+ * (about 35 ns per ACK), not in a packet-level simulation.
+ *
+ * The file is always truncated on open.  Use the tcp-do-audit-convert
+ * program to turn it into CSV and to line decisions up with goodput.
+ */
+class AuditLog : public SimpleRefCount<AuditLog>
+{
+public:
+    /**
+     * \brief Open \p filename for writing, truncating any previous content.
+     * \param filename output path
+     * \param capacity records in the ring, rounded up to a power of two
+     */
+    AuditLog(const std::string& filename, size_t capacity = 1 << 16);
+    ~AuditLog();
+
+    AuditLog(const AuditLog&) = delete;
+    AuditLog& operator=(const AuditLog&) = delete;
+
+    /**
+     * \brief Append \p record as a record of flow \p flowId.
+     *
+     * Must always be called from the same thread.
+     *
+     * \param flowId compact flow identifier, replaces record.flowId
+     * \param record the window update
+     */
+    void Write(uint32_t flowId, const TcpDoAuditRecord& record);
+
+    /**
+     * \brief Write everything recorded so far and close the file.
+     *
+     * Called by the destructor; further writes are ignored.
+     */
+    void Close();
+
+    /**
+     * \return the number of records accepted so far
+     */
+    uint64_t GetRecordCount() const;
+
+    /**
+     * \return the number of writes that waited for a full ring
+     */
+    uint64_t GetStallCount() const;
+
+    /**
+     * \return the number of records the writer failed to write
+     */
+    uint64_t GetFailedCount() const;
+
+private:
+    /**
+     * \brief Writer thread body.
+     */
+    void WriterLoop();
+
+    std::FILE* m_file;                    //!< Output file
+    std::vector<TcpDoAuditRecord> m_ring; //!< Records not written yet
+    uint64_t m_mask;                      //!< Ring size minus one
+    uint64_t m_cachedTail;                //!< Producer's last view of m_tail
+    uint64_t m_stalls;                    //!< Writes that found the ring full
+
+    alignas(64) std::atomic<uint64_t> m_head; //!< Records published, written by the producer
+    alignas(64) std::atomic<uint64_t> m_tail; //!< Records on disk, written by the writer
+    std::atomic<bool> m_closing;              //!< Set once Close() has been called
+    std::atomic<uint64_t> m_failed;           //!< Records lost to failed writes, written by the writer
+    std::thread m_writer;                     //!< Background writer
+};
+
+} // namespace ns3
+
+#endif // AUDIT_LOG_H
@@ -0,0 +1,90 @@
+#ifndef AUDIT_RECORD_H
+#define AUDIT_RECORD_H
+
+#include <cstdint>
+#include <cstring>
+
+namespace ns3 {
+
+/**
+ * \brief Fixed-size binary record of one TcpDo window update, written by
+ *        AuditLog.
+ *
+ * decision is a TcpDoDecision, with TCPDO_PROBE and TCPDO_DEFERRED or-ed in
+ * when set (a deferred update leaves cwnd and ssthresh unchanged), and
+ * causes the TcpDoCause flags of the signals seen by the update.
+ * TCPDO_BACKOFF records are written when the loss response sets ssthresh
+ * after a loss or the ECN response after a CE mark: cwndAfter is still the
+ * cwnd at that point, which the recovery algorithm adjusts afterwards, and
+ * rttThreshold holds the reference RTT of the RTT threshold rule, which the
+ * loss response compares against.  ECN backoff records (causes with
+ * TCPDO_CAUSE_ECN) carry the same reference RTT, which the ECN response
+ * does not use.  Records are stored back to back after an AuditFileHeader
+ * in host byte order.
+ *
+ * congestionThreshold is the threshold the oscillation metric was compared
+ * against.  TcpDo v1 raises its threshold by 1% on every update before
+ * comparing, so its records carry the raised value; the adaptation of the
+ * branch taken is only visible in the next record.
+ */
+struct TcpDoAuditRecord
+{
+    int64_t timeNs;            //!< Simulation time, nanoseconds
+    uint32_t flowId;           //!< Compact flow identifier
+    uint8_t decision;          //!< TcpDoDecision
+    uint8_t causes;            //!< TcpDoCause flags
+    uint16_t reserved;         //!< Padding, always zero
+    uint32_t cwndBefore;       //!< Congestion window before the update, bytes
+    uint32_t cwndAfter;        //!< Congestion window after the update, bytes
+    uint32_t ssThreshBefore;   //!< Slow start threshold before the update, bytes
+    uint32_t ssThreshAfter;    //!< Slow start threshold after the update, bytes
+    float severity;            //!< Oscillation metric over the threshold, 0 without a reduction
+    float reductionFactor;     //!< Factor applied to the reduced window, 1 without a reduction
+    float oscillation;         //!< Oscillation metric compared against the threshold, seconds
+    float congestionThreshold; //!< Threshold the oscillation was compared against, seconds
+    float rtt;                 //!< Last RTT sample, seconds
+    float rttThreshold;        //!< RTT threshold (or reference RTT), seconds
+};
+
+static_assert(sizeof(TcpDoAuditRecord) == 56, "TcpDoAuditRecord layout must stay fixed");
+
+/**
+ * \brief Header at the start of every binary audit file.
+ */
+struct AuditFileHeader
+{
+    char magic[8];       //!< "TCPAUDIT"
+    uint32_t version;    //!< Format version, currently 1
+    uint32_t recordSize; //!< sizeof(TcpDoAuditRecord)
+};
+
+static_assert(sizeof(AuditFileHeader) == 16, "AuditFileHeader layout must stay fixed");
+
+static const char AUDIT_FILE_MAGIC[8] = {'T', 'C', 'P', 'A', 'U', 'D', 'I', 'T'};
+static const uint32_t AUDIT_FILE_VERSION = 1;
+
+/**
+ * \return a header describing the current format
+ */
+inline AuditFileHeader MakeAuditFileHeader()
+{
+    AuditFileHeader header;
+    std::memcpy(header.magic, AUDIT_FILE_MAGIC, sizeof(header.magic));
+    header.version = AUDIT_FILE_VERSION;
+    header.recordSize = sizeof(TcpDoAuditRecord);
+    return header;
+}
+
+/**
+ * \param header a header read from an audit file
+ * \return true if the file was written in the current format
+ */
+inline bool IsValidAuditFileHeader(const AuditFileHeader& header)
+{
+    return std::memcmp(header.magic, AUDIT_FILE_MAGIC, sizeof(header.magic)) == 0 &&
+           header.version == AUDIT_FILE_VERSION && header.recordSize == sizeof(TcpDoAuditRecord);
+}
+
+} // namespace ns3
+
+#endif // AUDIT_RECORD_H
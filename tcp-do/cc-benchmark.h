@@ -0,0 +1,461 @@
+#ifndef CC_BENCHMARK_H
+#define CC_BENCHMARK_H
+
+#include "rtt-trace-reader.h"
+
+#include "ns3/core-module.h"
+#include "ns3/tcp-congestion-ops.h"
+#include "ns3/tcp-socket-state.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Per-ACK cost microbenchmark for congestion control algorithms.
+//
+// Drives PktsAcked() and IncreaseWindow() of a TcpCongestionOps on a
+// synthetic TcpSocketState with a generated or recorded RTT stream, without
+// sockets, links or packets, and reports nanoseconds, heap allocations and
+// (on Linux, where perf events are permitted) cache misses per ACK.
+//
+// Heap allocations are counted by the replacement global allocation
+// functions in tcp-do-bench.cc, which every program including this header
+// must link.
+
+namespace ns3 {
+
+extern bool g_countAllocations; //!< Set while benchmarked code runs
+extern uint64_t g_allocations;  //!< Allocations made while counting
+
+/**
+ * \brief User-space cache-miss counter backed by perf_event_open.
+ *
+ * Unavailable outside Linux, in containers without perf access or when
+ * perf_event_paranoid forbids it; every call is then a no-op.
+ */
+class CacheMissCounter
+{
+public:
+    CacheMissCounter()
+        : m_fd(-1)
+    {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~CacheMissCounter()
+    {
+#ifdef __linux__
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+#endif
+    }
+
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    /**
+     * \return true if the hardware counter could be opened
+     */
+    bool IsAvailable() const
+    {
+        return m_fd >= 0;
+    }
+
+    /**
+     * \brief Zero the counter.
+     */
+    void Reset()
+    {
+#ifdef __linux__
+        if (m_fd >= 0)
+        {
+            ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+        }
+#endif
+    }
+
+    /**
+     * \brief Start counting.
+     */
+    void Start()
+    {
+#ifdef __linux__
+        if (m_fd >= 0)
+        {
+            ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * \brief Stop counting; the value keeps accumulating across Start() calls.
+     */
+    void Stop()
+    {
+#ifdef __linux__
+        if (m_fd >= 0)
+        {
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * \return the misses counted since the last Reset()
+     */
+    uint64_t Read() const
+    {
+        uint64_t value = 0;
+#ifdef __linux__
+        if (m_fd >= 0 && read(m_fd, &value, sizeof(value)) != sizeof(value))
+        {
+            value = 0;
+        }
+#endif
+        return value;
+    }
+
+private:
+    int m_fd; //!< perf event descriptor, -1 if unavailable
+};
+
+/**
+ * \brief Cost of one algorithm over one RTT stream.
+ */
+struct CcBenchmarkResult
+{
+    std::string algorithm;    //!< TypeId name
+    uint64_t acks;            //!< ACKs processed
+    double nsPerAck;          //!< Wall time per ACK
+    double allocationsPerAck; //!< Heap allocations per ACK
+    double cacheMissesPerAck; //!< Cache misses per ACK, negative if unavailable
+    uint32_t finalCwnd;       //!< Congestion window after the last ACK, bytes
+};
+
+/**
+ * \brief Feeds an RTT stream to a congestion control, one ACK per sample.
+ *
+ * Samples are processed in batches of one simulator event per
+ * batchInterval, so Simulator::Now() advances with the sample times (at
+ * batch granularity) while the scheduler stays out of the timed region.
+ * Each ACK acknowledges one segment; the synthetic socket keeps its send
+ * sequence one congestion window ahead of the acknowledged sequence so
+ * per-RTT logic such as Vegas' fires at a realistic rate.
+ */
+class CcBenchmark
+{
+public:
+    /**
+     * \param samples RTT stream, sorted by time
+     * \param batchInterval simulated time covered by one timed batch
+     * \param segmentSize segment size of the synthetic socket
+     */
+    CcBenchmark(const std::vector<RttSample>& samples, Time batchInterval, uint32_t segmentSize)
+        : m_samples(samples),
+          m_batchInterval(batchInterval),
+          m_segmentSize(segmentSize),
+          m_next(0),
+          m_elapsedNs(0)
+    {
+    }
+
+    /**
+     * \brief Run the whole stream through a fresh instance of \p tid.
+     * \param tid a TcpCongestionOps subclass
+     * \return the measured cost
+     */
+    CcBenchmarkResult Run(TypeId tid)
+    {
+        ObjectFactory factory;
+        factory.SetTypeId(tid);
+        m_cc = factory.Create<TcpCongestionOps>();
+        NS_ABORT_MSG_UNLESS(m_cc, tid.GetName() << " is not a congestion control");
+
+        m_tcb = CreateObject<TcpSocketState>();
+        m_tcb->m_segmentSize = m_segmentSize;
+        m_tcb->m_initialCWnd = 10;
+        m_tcb->m_cWnd = 10 * m_segmentSize;
+        m_tcb->m_ssThresh = 0x7fffffff;
+        m_tcb->m_congState = TcpSocketState::CA_OPEN;
+        m_cc->Init(m_tcb);
+        m_cc->CongestionStateSet(m_tcb, TcpSocketState::CA_OPEN);
+
+        m_next = 0;
+        m_elapsedNs = 0;
+        g_allocations = 0;
+        m_cacheMisses.Reset();
+
+        Simulator::Schedule(m_samples.front().time, &CcBenchmark::RunBatch, this);
+        Simulator::Run();
+        Simulator::Destroy();
+
+        CcBenchmarkResult result;
+        result.algorithm = tid.GetName();
+        result.acks = m_samples.size();
+        result.nsPerAck = static_cast<double>(m_elapsedNs) / result.acks;
+        result.allocationsPerAck = static_cast<double>(g_allocations) / result.acks;
+        result.cacheMissesPerAck =
+            m_cacheMisses.IsAvailable() ? static_cast<double>(m_cacheMisses.Read()) / result.acks : -1.0;
+        result.finalCwnd = m_tcb->m_cWnd;
+
+        m_cc = nullptr;
+        m_tcb = nullptr;
+        return result;
+    }
+
+private:
+    void RunBatch()
+    {
+        Time limit = Simulator::Now() + m_batchInterval;
+        size_t end = m_next + 1;
+        while (end < m_samples.size() && m_samples[end].time < limit)
+        {
+            ++end;
+        }
+
+        // 측정 구간에는 ACK 처리만 포함
+        m_cacheMisses.Start();
+        g_countAllocations = true;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = m_next; i < end; ++i)
+        {
+            Ack(m_samples[i].rtt);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        g_countAllocations = false;
+        m_cacheMisses.Stop();
+
+        m_elapsedNs += std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+        m_next = end;
+        if (m_next < m_samples.size())
+        {
+            Time delay = m_samples[m_next].time - Simulator::Now();
+            Simulator::Schedule(delay.IsStrictlyPositive() ? delay : Time(0), &CcBenchmark::RunBatch, this);
+        }
+    }
+
+    void Ack(const Time& rtt)
+    {
+        m_tcb->m_lastAckedSeq += static_cast<int32_t>(m_segmentSize);
+        m_tcb->m_nextTxSequence = m_tcb->m_lastAckedSeq + static_cast<int32_t>(m_tcb->m_cWnd.Get());
+        m_tcb->m_bytesInFlight = m_tcb->m_cWnd.Get();
+        m_tcb->m_lastRtt = rtt;
+        m_cc->PktsAcked(m_tcb, 1, rtt);
+        m_cc->IncreaseWindow(m_tcb, 1);
+    }
+
+    const std::vector<RttSample>& m_samples; //!< RTT stream
+    Time m_batchInterval;                    //!< Simulated time per timed batch
+    uint32_t m_segmentSize;                  //!< Segment size, bytes
+    Ptr<TcpCongestionOps> m_cc;              //!< Algorithm under test
+    Ptr<TcpSocketState> m_tcb;               //!< Synthetic socket state
+    size_t m_next;                           //!< Next sample to feed
+    uint64_t m_elapsedNs;                    //!< Time spent in the timed regions
+    CacheMissCounter m_cacheMisses;          //!< Misses in the timed regions
+};
+
+/**
+ * \brief Generate \p acks RTT samples oscillating around a base RTT.
+ *
+ * rtt(t) = base + amplitude * sin(2 pi t / period) + N(0, jitter^2), at one
+ * sample per \p ackInterval and never below a microsecond.
+ */
+inline std::vector<RttSample> GenerateRttStream(uint32_t acks,
+                                                Time ackInterval,
+                                                Time base,
+                                                Time amplitude,
+                                                Time period,
+                                                Time jitter)
+{
+    Ptr<NormalRandomVariable> noise = CreateObject<NormalRandomVariable>();
+    noise->SetAttribute("Mean", DoubleValue(0.0));
+    noise->SetAttribute("Variance", DoubleValue(jitter.GetSeconds() * jitter.GetSeconds()));
+    noise->SetStream(1);
+
+    std::vector<RttSample> samples(acks);
+    for (uint32_t i = 0; i < acks; ++i)
+    {
+        Time now = TimeStep(ackInterval.GetTimeStep() * i);
+        double rtt = base.GetSeconds() +
+                     amplitude.GetSeconds() * std::sin(2 * M_PI * now.GetSeconds() / period.GetSeconds()) +
+                     noise->GetValue();
+        samples[i] = RttSample{now, Seconds(std::max(1e-6, rtt))};
+    }
+    return samples;
+}
+
+/**
+ * \brief Repeat a recorded stream until it holds \p acks samples.
+ *
+ * Every repetition is shifted by the recorded duration plus \p ackInterval.
+ */
+inline std::vector<RttSample> RepeatRttStream(const std::vector<RttSample>& recorded, uint32_t acks, Time ackInterval)
+{
+    NS_ABORT_MSG_IF(recorded.empty(), "The RTT trace holds no samples");
+    Time span = recorded.back().time - recorded.front().time + ackInterval;
+
+    std::vector<RttSample> samples(acks);
+    for (uint32_t i = 0; i < acks; ++i)
+    {
+        const RttSample& sample = recorded[i % recorded.size()];
+        Time offset = TimeStep(span.GetTimeStep() * (i / recorded.size()));
+        samples[i] = RttSample{sample.time - recorded.front().time + offset, sample.rtt};
+    }
+    return samples;
+}
+
+/**
+ * \brief Command line front end shared by the benchmark programs.
+ * \param argc argument count of main()
+ * \param argv arguments of main()
+ * \param program source file of main(), for the usage message
+ * \param algorithms default comma separated list of algorithms
+ * \return the exit status: 1 if a baseline was given and exceeded
+ */
+inline int CcBenchmarkMain(int argc, char* argv[], const char* program, std::string algorithms)
+{
+    std::string input;
+    int64_t flow = 0;
+    uint32_t acks = 1000000;
+    uint32_t segmentSize = 1448;
+    Time ackInterval = MicroSeconds(10);
+    Time batchInterval = MilliSeconds(1);
+    Time baseRtt = MilliSeconds(20);
+    Time amplitude = MilliSeconds(2);
+    Time period = MilliSeconds(50);
+    Time jitter = MicroSeconds(500);
+    uint32_t repeat = 3;
+    std::string csv;
+    std::string baseline;
+    double tolerance = 0.1;
+
+    CommandLine cmd(program);
+    cmd.AddValue("algorithms", "Comma separated congestion controls to measure", algorithms);
+    cmd.AddValue("input", "Recorded RTT trace (binary trace or CSV), generated stream if empty", input);
+    cmd.AddValue("flow", "Flow id to take from the trace, negative mixes every flow into one run", flow);
+    cmd.AddValue("acks", "ACKs per run; a recorded trace is repeated to reach this count", acks);
+    cmd.AddValue("segmentSize", "Segment size of the synthetic socket", segmentSize);
+    cmd.AddValue("ackInterval", "Time between generated ACKs", ackInterval);
+    cmd.AddValue("batchInterval", "Simulated time covered by one timed batch", batchInterval);
+    cmd.AddValue("baseRtt", "Mean of the generated RTT", baseRtt);
+    cmd.AddValue("amplitude", "Oscillation amplitude of the generated RTT", amplitude);
+    cmd.AddValue("period", "Oscillation period of the generated RTT", period);
+    cmd.AddValue("jitter", "Standard deviation of the generated RTT noise", jitter);
+    cmd.AddValue("repeat", "Runs per algorithm; the fastest is reported", repeat);
+    cmd.AddValue("csv", "Also write the results to this CSV file", csv);
+    cmd.AddValue("baseline", "CSV of an earlier run; fail if an algorithm got slower", baseline);
+    cmd.AddValue("tolerance", "Allowed relative slowdown against the baseline", tolerance);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(acks == 0 || repeat == 0, "--acks and --repeat must be positive");
+    std::vector<RttSample> samples =
+        input.empty() ? GenerateRttStream(acks, ackInterval, baseRtt, amplitude, period, jitter)
+                      : RepeatRttStream(ReadRttTrace(input, flow), acks, ackInterval);
+
+    std::map<std::string, double> reference;
+    if (!baseline.empty())
+    {
+        std::ifstream file(baseline);
+        NS_ABORT_MSG_UNLESS(file.is_open(), "Cannot open " << baseline);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::stringstream stream(line);
+            std::string algorithm;
+            std::string acksField;
+            std::string nsField;
+            if (std::getline(stream, algorithm, ',') && std::getline(stream, acksField, ',') &&
+                std::getline(stream, nsField, ',') && algorithm != "algorithm")
+            {
+                reference[algorithm] = std::strtod(nsField.c_str(), nullptr);
+            }
+        }
+    }
+
+    std::ofstream csvFile;
+    if (!csv.empty())
+    {
+        csvFile.open(csv, std::ios::out | std::ios::trunc);
+        NS_ABORT_MSG_UNLESS(csvFile.is_open(), "Cannot open " << csv);
+        csvFile << "algorithm,acks,ns_per_ack,allocations_per_ack,cache_misses_per_ack,final_cwnd\n";
+    }
+
+    std::printf("%-16s %10s %10s %12s %14s %12s\n", "algorithm", "acks", "ns/ack", "allocs/ack", "misses/ack",
+                "cwnd");
+
+    int status = 0;
+    CcBenchmark benchmark(samples, batchInterval, segmentSize);
+    std::stringstream list(algorithms);
+    std::string name;
+    while (std::getline(list, name, ','))
+    {
+        if (name.find("ns3::") != 0)
+        {
+            name = "ns3::" + name;
+        }
+        TypeId tid;
+        NS_ABORT_MSG_UNLESS(TypeId::LookupByNameFailSafe(name, &tid), "Unknown algorithm: " << name);
+
+        // 가장 빠른 실행을 보고하여 스케줄링 잡음을 줄임
+        CcBenchmarkResult best = benchmark.Run(tid);
+        for (uint32_t i = 1; i < repeat; ++i)
+        {
+            CcBenchmarkResult result = benchmark.Run(tid);
+            if (result.nsPerAck < best.nsPerAck)
+            {
+                best = result;
+            }
+        }
+
+        char misses[32] = "n/a";
+        if (best.cacheMissesPerAck >= 0)
+        {
+            std::snprintf(misses, sizeof(misses), "%.3f", best.cacheMissesPerAck);
+        }
+        std::printf("%-16s %10lu %10.1f %12.3f %14s %12u\n", best.algorithm.c_str() + 5,
+                    static_cast<unsigned long>(best.acks), best.nsPerAck, best.allocationsPerAck, misses,
+                    best.finalCwnd);
+        if (csvFile.is_open())
+        {
+            csvFile << best.algorithm << "," << best.acks << "," << best.nsPerAck << "," << best.allocationsPerAck
+                    << "," << best.cacheMissesPerAck << "," << best.finalCwnd << "\n";
+        }
+
+        auto it = reference.find(best.algorithm);
+        if (it != reference.end() && best.nsPerAck > it->second * (1 + tolerance))
+        {
+            std::printf("  regression: %.1f ns/ack against a baseline of %.1f\n", best.nsPerAck, it->second);
+            status = 1;
+        }
+    }
+    return status;
+}
+
+} // namespace ns3
+
+#endif // CC_BENCHMARK_H
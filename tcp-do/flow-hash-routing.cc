@@ -0,0 +1,149 @@
+#include "flow-hash-routing.h"
+
+#include "ns3/abort.h"
+#include "ns3/hash.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+
+#include <cstring>
+#include <ostream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("FlowHashRouting");
+
+NS_OBJECT_ENSURE_REGISTERED(FlowHashRouting);
+
+TypeId FlowHashRouting::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::FlowHashRouting")
+                            .SetParent<Ipv4RoutingProtocol>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<FlowHashRouting>();
+    return tid;
+}
+
+FlowHashRouting::FlowHashRouting()
+    : m_salt(0)
+{
+}
+
+void FlowHashRouting::AddNetworkRouteTo(Ipv4Address network,
+                                        Ipv4Mask networkMask,
+                                        Ipv4Address nextHop,
+                                        uint32_t interface)
+{
+    for (Route& route : m_routes)
+    {
+        if (route.network == network && route.mask == networkMask)
+        {
+            route.hops.push_back(NextHop{nextHop, interface});
+            return;
+        }
+    }
+    m_routes.push_back(Route{network, networkMask, {NextHop{nextHop, interface}}});
+}
+
+Ptr<Ipv4Route> FlowHashRouting::RouteOutput(Ptr<Packet> p,
+                                            const Ipv4Header& header,
+                                            Ptr<NetDevice> oif,
+                                            Socket::SocketErrno& sockerr)
+{
+    // 자신이 보내는 패킷은 목록의 다음 라우팅 프로토콜이 처리
+    sockerr = Socket::ERROR_NOROUTETOHOST;
+    return nullptr;
+}
+
+bool FlowHashRouting::RouteInput(Ptr<const Packet> p,
+                                 const Ipv4Header& header,
+                                 Ptr<const NetDevice> idev,
+                                 const UnicastForwardCallback& ucb,
+                                 const MulticastForwardCallback& mcb,
+                                 const LocalDeliverCallback& lcb,
+                                 const ErrorCallback& ecb)
+{
+    Ipv4Address destination = header.GetDestination();
+    if (destination.IsMulticast() || destination.IsBroadcast())
+    {
+        return false;
+    }
+    for (const Route& route : m_routes)
+    {
+        if (!route.mask.IsMatch(destination, route.network))
+        {
+            continue;
+        }
+
+        const NextHop& hop = route.hops[HashFlow(p, header) % route.hops.size()];
+        Ptr<Ipv4Route> ipv4Route = Create<Ipv4Route>();
+        ipv4Route->SetDestination(destination);
+        ipv4Route->SetGateway(hop.gateway);
+        ipv4Route->SetSource(m_ipv4->GetAddress(hop.interface, 0).GetLocal());
+        ipv4Route->SetOutputDevice(m_ipv4->GetNetDevice(hop.interface));
+        ucb(ipv4Route, p, header);
+        return true;
+    }
+    return false;
+}
+
+uint32_t FlowHashRouting::HashFlow(Ptr<const Packet> p, const Ipv4Header& header) const
+{
+    // 주소, 프로토콜, (TCP/UDP이면) 포트와 노드 id를 키로 사용
+    uint8_t key[17];
+    uint32_t source = header.GetSource().Get();
+    uint32_t destination = header.GetDestination().Get();
+    uint8_t protocol = header.GetProtocol();
+    std::memcpy(key, &source, 4);
+    std::memcpy(key + 4, &destination, 4);
+    std::memcpy(key + 8, &m_salt, 4);
+    key[12] = protocol;
+    std::memset(key + 13, 0, 4);
+    if ((protocol == 6 || protocol == 17) && header.GetFragmentOffset() == 0 && p->GetSize() >= 4)
+    {
+        // 두 프로토콜 모두 헤더의 첫 4바이트가 출발지와 목적지 포트
+        p->CopyData(key + 13, 4);
+    }
+    return Hash32(reinterpret_cast<const char*>(key), sizeof(key));
+}
+
+void FlowHashRouting::NotifyInterfaceUp(uint32_t interface)
+{
+}
+
+void FlowHashRouting::NotifyInterfaceDown(uint32_t interface)
+{
+}
+
+void FlowHashRouting::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress address)
+{
+}
+
+void FlowHashRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress address)
+{
+}
+
+void FlowHashRouting::SetIpv4(Ptr<Ipv4> ipv4)
+{
+    NS_ABORT_MSG_IF(m_ipv4, "FlowHashRouting is already attached to a node");
+    m_ipv4 = ipv4;
+    Ptr<Node> node = ipv4->GetObject<Node>();
+    m_salt = node ? node->GetId() : 0;
+}
+
+void FlowHashRouting::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit unit) const
+{
+    std::ostream* os = stream->GetStream();
+    *os << "Node: " << (m_ipv4 ? m_ipv4->GetObject<Node>()->GetId() : 0) << ", FlowHashRouting\n";
+    for (const Route& route : m_routes)
+    {
+        *os << route.network << "/" << route.mask.GetPrefixLength() << " via";
+        for (const NextHop& hop : route.hops)
+        {
+            *os << " " << hop.gateway << " (if " << hop.interface << ")";
+        }
+        *os << "\n";
+    }
+}
+
+} // namespace ns3
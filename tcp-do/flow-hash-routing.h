@@ -0,0 +1,96 @@
+#ifndef FLOW_HASH_ROUTING_H
+#define FLOW_HASH_ROUTING_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4.h"
+
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Per-flow ECMP for forwarded packets: every route holds several
+ *        next hops and each flow is hashed onto one of them.
+ *
+ * The flow key is the source and destination address, the protocol and,
+ * for unfragmented TCP and UDP packets, both ports, salted with the node id
+ * so that consecutive switches do not all pick the same index.  A flow
+ * keeps its path and is never reordered, while flows to the same
+ * destination spread over all next hops.
+ *
+ * Only forwarding is handled: RouteOutput() finds no route, so the node's
+ * own packets and destinations without a route here fall through to the
+ * next protocol of the node's Ipv4ListRouting, e.g. Ipv4StaticRouting.
+ * Routes are matched in the order they were added, not by prefix length.
+ */
+class FlowHashRouting : public Ipv4RoutingProtocol
+{
+public:
+    static TypeId GetTypeId(void);
+
+    FlowHashRouting();
+
+    /**
+     * \brief Add a next hop towards \p network.
+     *
+     * The first call for a network creates its route, every further call
+     * adds one more next hop to it.
+     *
+     * \param network destination network
+     * \param networkMask mask of \p network
+     * \param nextHop address of the next hop
+     * \param interface interface towards \p nextHop
+     */
+    void AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask, Ipv4Address nextHop, uint32_t interface);
+
+    // Override methods from Ipv4RoutingProtocol
+    virtual Ptr<Ipv4Route> RouteOutput(Ptr<Packet> p,
+                                       const Ipv4Header& header,
+                                       Ptr<NetDevice> oif,
+                                       Socket::SocketErrno& sockerr) override;
+    virtual bool RouteInput(Ptr<const Packet> p,
+                            const Ipv4Header& header,
+                            Ptr<const NetDevice> idev,
+                            const UnicastForwardCallback& ucb,
+                            const MulticastForwardCallback& mcb,
+                            const LocalDeliverCallback& lcb,
+                            const ErrorCallback& ecb) override;
+    virtual void NotifyInterfaceUp(uint32_t interface) override;
+    virtual void NotifyInterfaceDown(uint32_t interface) override;
+    virtual void NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress address) override;
+    virtual void NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress address) override;
+    virtual void SetIpv4(Ptr<Ipv4> ipv4) override;
+    virtual void PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit unit = Time::S) const override;
+
+private:
+    /**
+     * One next hop of a route.
+     */
+    struct NextHop
+    {
+        Ipv4Address gateway; //!< Address of the next hop
+        uint32_t interface;  //!< Interface towards the next hop
+    };
+
+    /**
+     * A destination network and its equal-cost next hops.
+     */
+    struct Route
+    {
+        Ipv4Address network;       //!< Destination network
+        Ipv4Mask mask;             //!< Mask of the network
+        std::vector<NextHop> hops; //!< Next hops, one picked per flow
+    };
+
+    // Hash of the flow key of a forwarded packet
+    uint32_t HashFlow(Ptr<const Packet> p, const Ipv4Header& header) const;
+
+    Ptr<Ipv4> m_ipv4;            //!< IPv4 of the node
+    uint32_t m_salt;             //!< Node id mixed into every hash
+    std::vector<Route> m_routes; //!< Routes in the order they were added
+};
+
+} // namespace ns3
+
+#endif // FLOW_HASH_ROUTING_H
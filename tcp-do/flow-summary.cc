@@ -0,0 +1,61 @@
+#include "flow-summary.h"
+
+#include <fstream>
+
+namespace ns3 {
+
+FlowSummary::Flow::Flow()
+    : rtt(1e-9),
+      goodput(1e-3)
+{
+}
+
+FlowSummary::Flow& FlowSummary::GetFlow(uint32_t flowId)
+{
+    if (flowId >= m_flows.size())
+    {
+        m_flows.resize(flowId + 1);
+    }
+    return m_flows[flowId];
+}
+
+void FlowSummary::RecordRtt(uint32_t flowId, Time rtt)
+{
+    GetFlow(flowId).rtt.Record(rtt.GetSeconds());
+}
+
+void FlowSummary::RecordGoodput(uint32_t flowId, double mbps)
+{
+    GetFlow(flowId).goodput.Record(mbps);
+}
+
+// 한 줄에 RTT(ms)와 goodput(Mbps) 분포를 기록
+static void WriteLine(std::ofstream& file,
+                      const std::string& flow,
+                      const LogLinearHistogram& rtt,
+                      const LogLinearHistogram& goodput)
+{
+    file << flow << "," << rtt.GetCount() << "," << rtt.GetMin() * 1e3 << "," << rtt.GetMean() * 1e3 << ","
+         << rtt.GetPercentile(0.50) * 1e3 << "," << rtt.GetPercentile(0.95) * 1e3 << ","
+         << rtt.GetPercentile(0.99) * 1e3 << "," << rtt.GetMax() * 1e3 << "," << goodput.GetCount() << ","
+         << goodput.GetMean() << "," << goodput.GetPercentile(0.50) << "," << goodput.GetPercentile(0.95) << ","
+         << goodput.GetPercentile(0.99) << "\n";
+}
+
+void FlowSummary::Write(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    file << "flow,rtt_samples,rtt_min_ms,rtt_mean_ms,rtt_p50_ms,rtt_p95_ms,rtt_p99_ms,rtt_max_ms,"
+            "goodput_bins,goodput_mean_mbps,goodput_p50_mbps,goodput_p95_mbps,goodput_p99_mbps\n";
+
+    Flow all;
+    for (uint32_t i = 0; i < m_flows.size(); ++i)
+    {
+        WriteLine(file, std::to_string(i), m_flows[i].rtt, m_flows[i].goodput);
+        all.rtt.Merge(m_flows[i].rtt);
+        all.goodput.Merge(m_flows[i].goodput);
+    }
+    WriteLine(file, "all", all.rtt, all.goodput);
+}
+
+} // namespace ns3
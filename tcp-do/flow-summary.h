@@ -0,0 +1,67 @@
+#ifndef FLOW_SUMMARY_H
+#define FLOW_SUMMARY_H
+
+#include "log-linear-histogram.h"
+
+#include "ns3/nstime.h"
+#include "ns3/simple-ref-count.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Per-flow RTT and goodput distributions kept in memory.
+ *
+ * FlowTracer feeds every RTT sample and ThroughputMonitor every goodput bin
+ * into a LogLinearHistogram per flow, so percentiles are available at the
+ * end of a run without writing or post-processing the raw samples.  Memory
+ * is bounded by the number of flows, not by the run length.
+ *
+ * Write() produces one CSV line per flow plus an "all" line merging every
+ * flow.
+ */
+class FlowSummary : public SimpleRefCount<FlowSummary>
+{
+public:
+    /**
+     * \brief Count an RTT sample of \p flowId.
+     * \param flowId compact flow id
+     * \param rtt the sample
+     */
+    void RecordRtt(uint32_t flowId, Time rtt);
+
+    /**
+     * \brief Count a goodput bin of \p flowId.
+     * \param flowId compact flow id
+     * \param mbps goodput of the bin in Mbps
+     */
+    void RecordGoodput(uint32_t flowId, double mbps);
+
+    /**
+     * \brief Write the per-flow and merged percentiles to \p filename.
+     * \param filename output path, truncated
+     */
+    void Write(const std::string& filename) const;
+
+private:
+    /**
+     * Distributions of one flow.
+     */
+    struct Flow
+    {
+        Flow();
+
+        LogLinearHistogram rtt;     //!< RTT in seconds, 1 ns steps
+        LogLinearHistogram goodput; //!< Goodput bins in Mbps, 1 kbps steps
+    };
+
+    Flow& GetFlow(uint32_t flowId);
+
+    std::vector<Flow> m_flows; //!< Indexed by flow id
+};
+
+} // namespace ns3
+
+#endif // FLOW_SUMMARY_H
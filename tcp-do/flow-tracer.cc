@@ -0,0 +1,299 @@
+#include "flow-tracer.h"
+
+#include "ns3/abort.h"
+#include "ns3/bulk-send-application.h"
+#include "ns3/log.h"
+#include "ns3/onoff-application.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/pointer.h"
+#include "ns3/queue-disc.h"
+#include "ns3/traffic-control-layer.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("FlowTracer");
+
+FlowTracer::FlowTracer(Ptr<TraceSink> sink, Ptr<FlowSummary> summary, Ptr<AuditLog> audit)
+    : m_sink(sink),
+      m_summary(summary),
+      m_audit(audit),
+      m_attached(0)
+{
+}
+
+void FlowTracer::Track(Ptr<Application> app, uint32_t flowId)
+{
+    uint32_t index = m_flows.size();
+    Flow flow;
+    flow.app = app;
+    flow.flowId = flowId;
+    flow.hook = MakeBoundCallback(&FlowTracer::HandleTx, this, index);
+    flow.attached = false;
+    m_flows.push_back(flow);
+
+    // 애플리케이션이 소켓을 만들고 첫 패킷을 보내는 순간 소켓 트레이스를 연결
+    bool connected = app->TraceConnectWithoutContext("Tx", m_flows.back().hook);
+    NS_ABORT_MSG_UNLESS(connected, "Application of flow " << flowId << " has no Tx trace source");
+}
+
+void FlowTracer::TrackSocket(Ptr<Socket> socket, uint32_t flowId)
+{
+    // 소켓이 이미 있으므로 Tx 훅 없이 바로 연결
+    ConnectSocket(socket, flowId);
+}
+
+void FlowTracer::TrackQueue(Ptr<NetDevice> device, uint32_t linkId)
+{
+    Ptr<PointToPointNetDevice> pointToPoint = DynamicCast<PointToPointNetDevice>(device);
+    NS_ABORT_MSG_UNLESS(pointToPoint, "Link " << linkId << " is not a point-to-point device");
+
+    uint32_t index = m_queues.size();
+    Time now = Simulator::Now();
+    m_queues.push_back(LinkQueue{linkId, 0, 0, now, now, 0.0, 0, 0, 0.0, 0, 0});
+    pointToPoint->GetQueue()->TraceConnectWithoutContext(
+        "PacketsInQueue",
+        MakeBoundCallback(&FlowTracer::DeviceQueueChanged, this, index));
+    pointToPoint->GetQueue()->TraceConnectWithoutContext(
+        "Drop",
+        MakeBoundCallback(&FlowTracer::DevicePacketDropped, this, index));
+
+    // 트래픽 제어 계층이 있으면 대부분의 대기 패킷은 루트 큐 디스크에 쌓임
+    Ptr<TrafficControlLayer> trafficControl = device->GetNode()->GetObject<TrafficControlLayer>();
+    Ptr<QueueDisc> queueDisc = trafficControl ? trafficControl->GetRootQueueDiscOnDevice(device) : nullptr;
+    if (queueDisc)
+    {
+        queueDisc->TraceConnectWithoutContext("PacketsInQueue",
+                                              MakeBoundCallback(&FlowTracer::QueueDiscChanged, this, index));
+        queueDisc->TraceConnectWithoutContext("Drop",
+                                              MakeBoundCallback(&FlowTracer::QueueDiscItemDropped, this, index));
+        queueDisc->TraceConnectWithoutContext("SojournTime",
+                                              MakeBoundCallback(&FlowTracer::SojournTimeRecorded, this, index));
+        queueDisc->TraceConnectWithoutContext("Mark",
+                                              MakeBoundCallback(&FlowTracer::QueueDiscItemMarked, this, index));
+    }
+}
+
+uint32_t FlowTracer::GetAttachedCount() const
+{
+    return m_attached;
+}
+
+std::vector<FlowTracer::QueueStats> FlowTracer::GetQueueStats(Time end) const
+{
+    std::vector<QueueStats> stats;
+    for (const LinkQueue& queue : m_queues)
+    {
+        // 마지막 변경 이후 end까지의 구간을 더해 시간 가중 평균을 구함
+        uint32_t packets = queue.devicePackets + queue.discPackets;
+        double packetSeconds = queue.packetSeconds + packets * (end - queue.lastChange).GetSeconds();
+        double duration = (end - queue.start).GetSeconds();
+        stats.push_back(QueueStats{queue.linkId,
+                                   duration > 0 ? packetSeconds / duration : 0.0,
+                                   queue.maxPackets,
+                                   queue.drops,
+                                   queue.sojourns > 0 ? queue.sojournSum / queue.sojourns : 0.0,
+                                   queue.marks});
+    }
+    return stats;
+}
+
+void FlowTracer::WriteQueueStats(const std::string& filename, Time end) const
+{
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    file << "link,mean_packets,max_packets,drops,mean_sojourn_ms,marks\n";
+    for (const QueueStats& stats : GetQueueStats(end))
+    {
+        file << stats.linkId << "," << stats.meanPackets << "," << stats.maxPackets << "," << stats.drops << ","
+             << stats.meanSojourn * 1e3 << "," << stats.marks << "\n";
+    }
+}
+
+void FlowTracer::HandleTx(FlowTracer* tracer, uint32_t index, Ptr<const Packet> packet)
+{
+    if (!tracer->m_flows[index].attached)
+    {
+        tracer->Attach(index);
+    }
+}
+
+void FlowTracer::Attach(uint32_t index)
+{
+    Flow& flow = m_flows[index];
+
+    Ptr<Socket> socket;
+    if (Ptr<OnOffApplication> onOff = DynamicCast<OnOffApplication>(flow.app))
+    {
+        socket = onOff->GetSocket();
+    }
+    else if (Ptr<BulkSendApplication> bulkSend = DynamicCast<BulkSendApplication>(flow.app))
+    {
+        socket = bulkSend->GetSocket();
+    }
+    ConnectSocket(socket, flow.flowId);
+    flow.attached = true;
+
+    // 콜백 실행 중에는 목록을 수정할 수 없으므로 Tx 훅은 다음 이벤트에서 제거
+    Simulator::ScheduleNow(&FlowTracer::RemoveHook, this, index);
+}
+
+void FlowTracer::ConnectSocket(Ptr<Socket> socket, uint32_t flowId)
+{
+    Ptr<TcpSocketBase> tcpSocket = DynamicCast<TcpSocketBase>(socket);
+    NS_ABORT_MSG_UNLESS(tcpSocket, "Flow " << flowId << " is not sending over a TCP socket");
+
+    if (m_sink || m_summary)
+    {
+        tcpSocket->TraceConnectWithoutContext("RTT", MakeBoundCallback(&FlowTracer::RttChanged, this, flowId));
+    }
+
+    // 원시 샘플을 기록하지 않으면 나머지 트레이스는 연결하지 않음
+    if (m_sink)
+    {
+        TraceSink* sink = PeekPointer(m_sink);
+        tcpSocket->TraceConnectWithoutContext("CongestionWindow",
+                                              MakeBoundCallback(&FlowTracer::CwndChanged, sink, flowId));
+        tcpSocket->TraceConnectWithoutContext("SlowStartThreshold",
+                                              MakeBoundCallback(&FlowTracer::SsThreshChanged, sink, flowId));
+        tcpSocket->TraceConnectWithoutContext("BytesInFlight",
+                                              MakeBoundCallback(&FlowTracer::BytesInFlightChanged, sink, flowId));
+        tcpSocket->TraceConnectWithoutContext("CongState",
+                                              MakeBoundCallback(&FlowTracer::CongStateChanged, sink, flowId));
+    }
+
+    if (m_audit)
+    {
+        PointerValue congestionOps;
+        NS_ABORT_MSG_UNLESS(tcpSocket->GetAttributeFailSafe("CongestionOps", congestionOps),
+                            "TCP sockets do not expose their congestion control");
+        Ptr<TcpCongestionOps> cc = congestionOps.Get<TcpCongestionOps>();
+        // TcpDo 계열이 아니면 Audit 트레이스가 없으므로 연결되지 않음
+        if (cc && !cc->TraceConnectWithoutContext(
+                      "Audit",
+                      MakeBoundCallback(&FlowTracer::AuditRecorded, PeekPointer(m_audit), flowId)))
+        {
+            NS_LOG_INFO("Flow " << flowId << " uses " << cc->GetName() << ", which has no audit stream");
+        }
+    }
+
+    ++m_attached;
+    NS_LOG_INFO("Attached traces of flow " << flowId << " at " << Simulator::Now().GetSeconds() << "s");
+}
+
+void FlowTracer::RemoveHook(uint32_t index)
+{
+    Flow& flow = m_flows[index];
+    flow.app->TraceDisconnectWithoutContext("Tx", flow.hook);
+}
+
+void FlowTracer::RttChanged(FlowTracer* tracer, uint32_t flowId, Time oldValue, Time newValue)
+{
+    if (tracer->m_sink)
+    {
+        tracer->m_sink->Write(flowId, TRACE_RTT, newValue.GetSeconds());
+    }
+    if (tracer->m_summary)
+    {
+        tracer->m_summary->RecordRtt(flowId, newValue);
+    }
+}
+
+void FlowTracer::CwndChanged(TraceSink* sink, uint32_t flowId, uint32_t oldValue, uint32_t newValue)
+{
+    sink->Write(flowId, TRACE_CWND, newValue);
+}
+
+void FlowTracer::SsThreshChanged(TraceSink* sink, uint32_t flowId, uint32_t oldValue, uint32_t newValue)
+{
+    sink->Write(flowId, TRACE_SSTHRESH, newValue);
+}
+
+void FlowTracer::BytesInFlightChanged(TraceSink* sink, uint32_t flowId, uint32_t oldValue, uint32_t newValue)
+{
+    sink->Write(flowId, TRACE_BYTES_IN_FLIGHT, newValue);
+}
+
+void FlowTracer::CongStateChanged(TraceSink* sink,
+                                  uint32_t flowId,
+                                  TcpSocketState::TcpCongState_t oldValue,
+                                  TcpSocketState::TcpCongState_t newValue)
+{
+    sink->Write(flowId, TRACE_CONG_STATE, static_cast<double>(newValue));
+}
+
+void FlowTracer::DeviceQueueChanged(FlowTracer* tracer, uint32_t index, uint32_t oldValue, uint32_t newValue)
+{
+    LinkQueue& queue = tracer->m_queues[index];
+    tracer->SetQueueLength(queue, newValue, queue.discPackets);
+}
+
+void FlowTracer::QueueDiscChanged(FlowTracer* tracer, uint32_t index, uint32_t oldValue, uint32_t newValue)
+{
+    LinkQueue& queue = tracer->m_queues[index];
+    tracer->SetQueueLength(queue, queue.devicePackets, newValue);
+}
+
+void FlowTracer::DevicePacketDropped(FlowTracer* tracer, uint32_t index, Ptr<const Packet> packet)
+{
+    tracer->CountDrop(tracer->m_queues[index]);
+}
+
+void FlowTracer::QueueDiscItemDropped(FlowTracer* tracer, uint32_t index, Ptr<const QueueDiscItem> item)
+{
+    tracer->CountDrop(tracer->m_queues[index]);
+}
+
+void FlowTracer::SojournTimeRecorded(FlowTracer* tracer, uint32_t index, Time sojourn)
+{
+    LinkQueue& queue = tracer->m_queues[index];
+    queue.sojournSum += sojourn.GetSeconds();
+    ++queue.sojourns;
+    if (tracer->m_sink)
+    {
+        tracer->m_sink->Write(queue.linkId, TRACE_SOJOURN, sojourn.GetSeconds());
+    }
+}
+
+void FlowTracer::QueueDiscItemMarked(FlowTracer* tracer,
+                                     uint32_t index,
+                                     Ptr<const QueueDiscItem> item,
+                                     const char* reason)
+{
+    ++tracer->m_queues[index].marks;
+}
+
+void FlowTracer::CountDrop(LinkQueue& queue)
+{
+    ++queue.drops;
+    if (m_sink)
+    {
+        m_sink->Write(queue.linkId, TRACE_DROP, queue.drops);
+    }
+}
+
+void FlowTracer::SetQueueLength(LinkQueue& queue, uint32_t devicePackets, uint32_t discPackets)
+{
+    // 길이가 바뀌기 전까지의 구간을 적분
+    Time now = Simulator::Now();
+    queue.packetSeconds += (queue.devicePackets + queue.discPackets) * (now - queue.lastChange).GetSeconds();
+    queue.lastChange = now;
+    queue.devicePackets = devicePackets;
+    queue.discPackets = discPackets;
+
+    uint32_t packets = devicePackets + discPackets;
+    queue.maxPackets = std::max(queue.maxPackets, packets);
+    if (m_sink)
+    {
+        m_sink->Write(queue.linkId, TRACE_QUEUE, packets);
+    }
+}
+
+void FlowTracer::AuditRecorded(AuditLog* audit, uint32_t flowId, const TcpDoAuditRecord& record)
+{
+    audit->Write(flowId, record);
+}
+
+} // namespace ns3
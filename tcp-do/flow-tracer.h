@@ -0,0 +1,184 @@
+#ifndef FLOW_TRACER_H
+#define FLOW_TRACER_H
+
+#include "audit-log.h"
+#include "flow-summary.h"
+#include "trace-sink.h"
+
+#include "ns3/application.h"
+#include "ns3/callback.h"
+#include "ns3/net-device.h"
+#include "ns3/packet.h"
+#include "ns3/queue-item.h"
+#include "ns3/tcp-socket-base.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Attaches per-socket TCP traces of many flows to one TraceSink.
+ *
+ * For every tracked sender application the tracer waits for the
+ * application's first transmission, which happens right after it has
+ * created and connected its socket, and then connects the RTT, congestion
+ * window, slow start threshold, bytes in flight and congestion state
+ * traces of that socket directly.  No fixed start-up timer or Config path
+ * lookup is involved, every record carries the compact flow id passed to
+ * Track(), and all flows share the same sink.
+ *
+ * RTT samples also feed an optional FlowSummary.  Without a sink only the
+ * RTT trace is connected, and only if a summary is given.
+ *
+ * TrackQueue() adds the length of a link's transmit queue, device queue
+ * plus root queue disc, as TRACE_QUEUE records under an id of its own.  The
+ * time-weighted mean and maximum length and the packets dropped by either
+ * queue are kept for GetQueueStats(), with or without a sink.  If the device
+ * has a root queue disc (an AQM installed through TrafficControlHelper), the
+ * sojourn time of every dequeued packet is written as TRACE_SOJOURN and the
+ * running drop count as TRACE_DROP records under the same id; packets it
+ * ECN-marks instead of dropping are counted as well.
+ *
+ * With an AuditLog the Audit trace source of the socket's congestion
+ * control is connected as well, for TcpDo sockets; other congestion
+ * controls have no such source and are skipped.
+ *
+ * Works with OnOffApplication and BulkSendApplication senders, and with
+ * sockets passed to TrackSocket() directly.
+ */
+class FlowTracer : public SimpleRefCount<FlowTracer>
+{
+public:
+    /**
+     * Occupancy and drops of one traced link queue.
+     */
+    struct QueueStats
+    {
+        uint32_t linkId;     //!< Id passed to TrackQueue()
+        double meanPackets;  //!< Time-weighted mean length, packets
+        uint32_t maxPackets; //!< Longest length seen, packets
+        uint64_t drops;      //!< Packets dropped by the device queue or queue disc
+        double meanSojourn;  //!< Mean time spent in the queue disc, seconds, 0 without one
+        uint64_t marks;      //!< Packets ECN-marked by the queue disc
+    };
+
+    /**
+     * \param sink destination of every record, may be null
+     * \param summary RTT distribution per flow, may be null
+     * \param audit destination of the TcpDo decision audit stream, may be null
+     */
+    FlowTracer(Ptr<TraceSink> sink, Ptr<FlowSummary> summary = nullptr, Ptr<AuditLog> audit = nullptr);
+
+    /**
+     * \brief Trace the socket of \p app as flow \p flowId once it exists.
+     * \param app an OnOffApplication or BulkSendApplication
+     * \param flowId compact id written with every record of this flow
+     */
+    void Track(Ptr<Application> app, uint32_t flowId);
+
+    /**
+     * \brief Trace \p socket as flow \p flowId right away.
+     *
+     * For senders without an application, e.g. the workers of
+     * IncastWorkload, which create their sockets themselves.
+     *
+     * \param socket a TcpSocketBase
+     * \param flowId compact id written with every record of this flow
+     */
+    void TrackSocket(Ptr<Socket> socket, uint32_t flowId);
+
+    /**
+     * \brief Trace the packets queued for transmission on \p device.
+     *
+     * \param device a PointToPointNetDevice
+     * \param linkId id written with every record of this queue, distinct
+     *        from the flow ids
+     */
+    void TrackQueue(Ptr<NetDevice> device, uint32_t linkId);
+
+    /**
+     * \return the number of flows whose socket traces are connected
+     */
+    uint32_t GetAttachedCount() const;
+
+    /**
+     * \param end end of the measurement, closes the time-weighted means
+     * \return statistics of every traced queue in TrackQueue() order
+     */
+    std::vector<QueueStats> GetQueueStats(Time end) const;
+
+    /**
+     * \brief Write one CSV line of statistics per traced queue to \p filename.
+     * \param filename output path, truncated
+     * \param end end of the measurement
+     */
+    void WriteQueueStats(const std::string& filename, Time end) const;
+
+private:
+    /**
+     * A tracked application and the hook waiting for its socket.
+     */
+    struct Flow
+    {
+        Ptr<Application> app;                   //!< Sender application
+        uint32_t flowId;                        //!< Id written to the sink
+        Callback<void, Ptr<const Packet>> hook; //!< Tx hook until the socket is attached
+        bool attached;                          //!< True once socket traces are connected
+    };
+
+    /**
+     * Packets queued at a traced link.
+     */
+    struct LinkQueue
+    {
+        uint32_t linkId;        //!< Id written to the sink
+        uint32_t devicePackets; //!< Packets in the device queue
+        uint32_t discPackets;   //!< Packets in the root queue disc
+        Time start;             //!< Time TrackQueue() was called
+        Time lastChange;        //!< Time of the last length change
+        double packetSeconds;   //!< Length integrated up to lastChange
+        uint32_t maxPackets;    //!< Longest length seen
+        uint64_t drops;         //!< Packets dropped
+        double sojournSum;      //!< Sum of queue disc sojourn times, seconds
+        uint64_t sojourns;      //!< Packets dequeued from the queue disc
+        uint64_t marks;         //!< Packets ECN-marked by the queue disc
+    };
+
+    static void HandleTx(FlowTracer* tracer, uint32_t index, Ptr<const Packet> packet);
+    void Attach(uint32_t index);
+    void ConnectSocket(Ptr<Socket> socket, uint32_t flowId);
+    void RemoveHook(uint32_t index);
+
+    static void RttChanged(FlowTracer* tracer, uint32_t flowId, Time oldValue, Time newValue);
+    static void CwndChanged(TraceSink* sink, uint32_t flowId, uint32_t oldValue, uint32_t newValue);
+    static void SsThreshChanged(TraceSink* sink, uint32_t flowId, uint32_t oldValue, uint32_t newValue);
+    static void BytesInFlightChanged(TraceSink* sink, uint32_t flowId, uint32_t oldValue, uint32_t newValue);
+    static void CongStateChanged(TraceSink* sink,
+                                 uint32_t flowId,
+                                 TcpSocketState::TcpCongState_t oldValue,
+                                 TcpSocketState::TcpCongState_t newValue);
+    static void DeviceQueueChanged(FlowTracer* tracer, uint32_t index, uint32_t oldValue, uint32_t newValue);
+    static void QueueDiscChanged(FlowTracer* tracer, uint32_t index, uint32_t oldValue, uint32_t newValue);
+    static void DevicePacketDropped(FlowTracer* tracer, uint32_t index, Ptr<const Packet> packet);
+    static void QueueDiscItemDropped(FlowTracer* tracer, uint32_t index, Ptr<const QueueDiscItem> item);
+    static void SojournTimeRecorded(FlowTracer* tracer, uint32_t index, Time sojourn);
+    static void QueueDiscItemMarked(FlowTracer* tracer,
+                                    uint32_t index,
+                                    Ptr<const QueueDiscItem> item,
+                                    const char* reason);
+    void CountDrop(LinkQueue& queue);
+    void SetQueueLength(LinkQueue& queue, uint32_t devicePackets, uint32_t discPackets);
+    static void AuditRecorded(AuditLog* audit, uint32_t flowId, const TcpDoAuditRecord& record);
+
+    Ptr<TraceSink> m_sink;           //!< Shared sink, may be null
+    Ptr<FlowSummary> m_summary;      //!< RTT distributions, may be null
+    Ptr<AuditLog> m_audit;           //!< TcpDo decision audit log, may be null
+    std::vector<Flow> m_flows;       //!< Tracked flows
+    std::vector<LinkQueue> m_queues; //!< Traced link queues
+    uint32_t m_attached;             //!< Flows with connected socket traces
+};
+
+} // namespace ns3
+
+#endif // FLOW_TRACER_H
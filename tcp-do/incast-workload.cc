@@ -0,0 +1,288 @@
+#include "incast-workload.h"
+
+#include "ns3/abort.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/ipv4.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/tcp-socket-base.h"
+#include "ns3/tcp-socket-factory.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("IncastWorkload");
+
+IncastWorkload::IncastWorkload(Ptr<Node> aggregator,
+                               Ipv4Address address,
+                               const NodeContainer& workers,
+                               const Settings& settings,
+                               Ptr<FlowTracer> tracer)
+    : m_aggregator(aggregator),
+      m_address(address),
+      m_settings(settings),
+      m_tracer(tracer),
+      m_connected(0),
+      m_accepted(0),
+      m_outstanding(0),
+      m_completed(0),
+      m_timeouts(0),
+      m_qct(1e-9)
+{
+    NS_ABORT_MSG_IF(workers.GetN() == 0, "Incast needs at least one worker");
+    if (m_settings.fanIn == 0)
+    {
+        m_settings.fanIn = workers.GetN();
+    }
+    NS_ABORT_MSG_IF(m_settings.fanIn > workers.GetN(),
+                    "Fan-in " << m_settings.fanIn << " exceeds the " << workers.GetN() << " workers");
+    NS_ABORT_MSG_IF(m_settings.requestSize == 0, "Incast requests must not be empty");
+
+    for (uint32_t i = 0; i < workers.GetN(); ++i)
+    {
+        Ptr<Node> node = workers.Get(i);
+        m_workers.push_back(Worker{node, nullptr, nullptr, 0, 0, 0, 0, false});
+        m_order.push_back(i);
+
+        // 작업자 호스트는 인터페이스가 하나뿐이므로 주소로 연결을 구분
+        Ipv4Address workerAddress = node->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal();
+        m_byAddress[workerAddress] = i;
+    }
+
+    m_choice = CreateObject<UniformRandomVariable>();
+    m_choice->SetStream(3);
+}
+
+void IncastWorkload::Start(Time start)
+{
+    m_listener = Socket::CreateSocket(m_aggregator, TcpSocketFactory::GetTypeId());
+    m_listener->Bind(InetSocketAddress(Ipv4Address::GetAny(), m_settings.port));
+    m_listener->Listen();
+    m_listener->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                                  MakeBoundCallback(&IncastWorkload::HandleAccept, this));
+
+    Simulator::Schedule(start, &IncastWorkload::Connect, this);
+}
+
+void IncastWorkload::Connect()
+{
+    for (uint32_t i = 0; i < m_workers.size(); ++i)
+    {
+        Worker& worker = m_workers[i];
+        worker.socket = Socket::CreateSocket(worker.node, TcpSocketFactory::GetTypeId());
+        worker.socket->Bind();
+        worker.socket->SetConnectCallback(MakeBoundCallback(&IncastWorkload::HandleConnected, this),
+                                          MakeBoundCallback(&IncastWorkload::HandleConnectFailed, this, i));
+        worker.socket->SetSendCallback(MakeBoundCallback(&IncastWorkload::HandleSend, this, i));
+        worker.socket->SetRecvCallback(MakeBoundCallback(&IncastWorkload::HandleRequest, this, i));
+
+        Ptr<TcpSocketBase> tcpSocket = DynamicCast<TcpSocketBase>(worker.socket);
+        NS_ABORT_MSG_UNLESS(tcpSocket, "Worker " << i << " is not sending over a TCP socket");
+        tcpSocket->TraceConnectWithoutContext("CongState",
+                                              MakeBoundCallback(&IncastWorkload::CongStateChanged, this, i));
+        if (m_tracer)
+        {
+            m_tracer->TrackSocket(worker.socket, i);
+        }
+
+        worker.socket->Connect(InetSocketAddress(m_address, m_settings.port));
+    }
+}
+
+void IncastWorkload::HandleAccept(IncastWorkload* workload, Ptr<Socket> socket, const Address& from)
+{
+    Ipv4Address address = InetSocketAddress::ConvertFrom(from).GetIpv4();
+    auto worker = workload->m_byAddress.find(address);
+    NS_ABORT_MSG_IF(worker == workload->m_byAddress.end(), "Connection from unknown worker " << address);
+
+    socket->SetRecvCallback(MakeBoundCallback(&IncastWorkload::HandleRecv, workload, worker->second));
+    workload->m_workers[worker->second].accepted = socket;
+    ++workload->m_accepted;
+    workload->IssueFirst();
+}
+
+void IncastWorkload::HandleConnected(IncastWorkload* workload, Ptr<Socket> socket)
+{
+    ++workload->m_connected;
+    workload->IssueFirst();
+}
+
+void IncastWorkload::IssueFirst()
+{
+    // 양쪽 모두 연결이 맺어진 뒤 첫 질의를 시작하여 핸드셰이크가 QCT에 섞이지 않도록 함
+    // (aggregator의 수락은 작업자의 연결 완료보다 늦을 수 있음)
+    if (m_connected < m_workers.size() || m_accepted < m_workers.size() || !m_queries.empty())
+    {
+        return;
+    }
+    NS_LOG_INFO("All " << m_connected << " workers connected at " << Simulator::Now().GetSeconds() << "s");
+    Issue();
+}
+
+void IncastWorkload::HandleConnectFailed(IncastWorkload* workload, uint32_t index, Ptr<Socket> socket)
+{
+    NS_ABORT_MSG("Worker " << index << " could not connect to the aggregator");
+}
+
+void IncastWorkload::Issue()
+{
+    m_queries.push_back(Query{Simulator::Now(), Seconds(-1), 0});
+
+    // 부분 Fisher-Yates 셔플로 중복 없이 fanIn개의 작업자를 선택
+    uint32_t n = m_order.size();
+    for (uint32_t i = 0; i < m_settings.fanIn; ++i)
+    {
+        uint32_t j = i + m_choice->GetInteger(0, n - 1 - i);
+        std::swap(m_order[i], m_order[j]);
+
+        Worker& worker = m_workers[m_order[i]];
+        worker.expected += m_settings.responseSize;
+        worker.waiting = true;
+    }
+    m_outstanding = m_settings.fanIn;
+
+    // 응답은 작업자가 요청을 모두 받은 뒤에야 시작되므로 요청 구간도 QCT에 포함됨
+    for (uint32_t i = 0; i < m_settings.fanIn; ++i)
+    {
+        Ptr<Socket> socket = m_workers[m_order[i]].accepted;
+        int sent = socket->Send(Create<Packet>(m_settings.requestSize));
+        NS_ABORT_MSG_IF(sent != static_cast<int>(m_settings.requestSize),
+                        "Request to worker " << m_order[i] << " does not fit the aggregator's send buffer");
+    }
+}
+
+void IncastWorkload::HandleRequest(IncastWorkload* workload, uint32_t index, Ptr<Socket> socket)
+{
+    Worker& worker = workload->m_workers[index];
+    Ptr<Packet> packet;
+    while ((packet = socket->Recv()))
+    {
+        worker.requested += packet->GetSize();
+    }
+
+    // 요청이 세그먼트로 나뉘어 올 수 있으므로 완전히 도착한 요청마다 응답
+    uint32_t requestSize = workload->m_settings.requestSize;
+    while (worker.requested >= requestSize)
+    {
+        worker.requested -= requestSize;
+        worker.pending += workload->m_settings.responseSize;
+    }
+    workload->Fill(index);
+}
+
+void IncastWorkload::Fill(uint32_t index)
+{
+    // 송신 버퍼가 허용하는 만큼만 넘기고 나머지는 송신 콜백에서 이어서 보냄
+    Worker& worker = m_workers[index];
+    while (worker.pending > 0)
+    {
+        uint32_t size = std::min<uint64_t>(worker.pending, worker.socket->GetTxAvailable());
+        if (size == 0)
+        {
+            break;
+        }
+        int sent = worker.socket->Send(Create<Packet>(size));
+        if (sent <= 0)
+        {
+            break;
+        }
+        worker.pending -= sent;
+    }
+}
+
+void IncastWorkload::HandleSend(IncastWorkload* workload, uint32_t index, Ptr<Socket> socket, uint32_t available)
+{
+    workload->Fill(index);
+}
+
+void IncastWorkload::HandleRecv(IncastWorkload* workload, uint32_t index, Ptr<Socket> socket)
+{
+    Worker& worker = workload->m_workers[index];
+    Ptr<Packet> packet;
+    while ((packet = socket->Recv()))
+    {
+        worker.received += packet->GetSize();
+    }
+
+    if (!worker.waiting || worker.received < worker.expected)
+    {
+        return;
+    }
+    worker.waiting = false;
+    if (--workload->m_outstanding > 0)
+    {
+        return;
+    }
+
+    // 마지막 응답이 도착한 시점에 질의 완료
+    Query& query = workload->m_queries.back();
+    query.completion = Simulator::Now() - query.start;
+    workload->m_qct.Record(query.completion.GetSeconds());
+    ++workload->m_completed;
+    if (workload->m_queries.size() < workload->m_settings.queries)
+    {
+        Simulator::Schedule(workload->m_settings.gap, &IncastWorkload::Issue, workload);
+    }
+}
+
+void IncastWorkload::CongStateChanged(IncastWorkload* workload,
+                                      uint32_t index,
+                                      TcpSocketState::TcpCongState_t oldValue,
+                                      TcpSocketState::TcpCongState_t newValue)
+{
+    if (newValue != TcpSocketState::CA_LOSS)
+    {
+        return;
+    }
+    ++workload->m_timeouts;
+    if (!workload->m_queries.empty() && workload->m_queries.back().completion.IsNegative())
+    {
+        ++workload->m_queries.back().timeouts;
+    }
+}
+
+uint32_t IncastWorkload::GetIssuedCount() const
+{
+    return m_queries.size();
+}
+
+uint32_t IncastWorkload::GetCompletedCount() const
+{
+    return m_completed;
+}
+
+uint64_t IncastWorkload::GetTimeoutCount() const
+{
+    return m_timeouts;
+}
+
+uint32_t IncastWorkload::GetQueriesWithTimeout() const
+{
+    return std::count_if(m_queries.begin(), m_queries.end(), [](const Query& query) { return query.timeouts > 0; });
+}
+
+const LogLinearHistogram& IncastWorkload::GetQct() const
+{
+    return m_qct;
+}
+
+void IncastWorkload::WriteQueryStats(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    file << "query,start_s,qct_ms,timeouts\n";
+    for (uint32_t i = 0; i < m_queries.size(); ++i)
+    {
+        const Query& query = m_queries[i];
+        file << i << "," << query.start.GetSeconds() << ",";
+        if (!query.completion.IsNegative())
+        {
+            file << query.completion.GetSeconds() * 1e3;
+        }
+        file << "," << query.timeouts << "\n";
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,171 @@
+#ifndef INCAST_WORKLOAD_H
+#define INCAST_WORKLOAD_H
+
+#include "flow-tracer.h"
+#include "log-linear-histogram.h"
+
+#include "ns3/ipv4-address.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/socket.h"
+#include "ns3/tcp-socket-state.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Partition/aggregate incast: one aggregator queries many workers.
+ *
+ * Every worker keeps one TCP connection to the aggregator open for the
+ * whole run.  A query picks fanIn workers at random and the aggregator
+ * sends each of them a request of requestSize bytes over its connection;
+ * a worker answers with responseSize bytes at once as soon as the whole
+ * request has arrived, and the query completes when the last response has
+ * fully arrived.  The completion time thus covers both legs, and requests
+ * queue behind the responses of the previous query like real traffic.
+ * Queries are closed loop: the next one starts gap after the previous
+ * completion, until the configured number has been issued.
+ *
+ * The query completion time (QCT) of every query goes into a
+ * LogLinearHistogram, and every RTO of a worker socket (a CA_LOSS
+ * transition) is counted against the query in progress; with incast the
+ * synchronized responses overflow the aggregator's last hop and those
+ * timeouts dominate the tail.  Every worker socket is handed to an optional
+ * FlowTracer under the worker's index as soon as it exists, so RTT
+ * summaries, raw traces and the TcpDo audit stream cover the workers like
+ * any other flow.
+ */
+class IncastWorkload : public SimpleRefCount<IncastWorkload>
+{
+public:
+    /**
+     * Shape of the workload.
+     */
+    struct Settings
+    {
+        uint32_t fanIn = 8;            //!< Workers answering each query, 0 for all
+        uint32_t requestSize = 64;     //!< Bytes sent to every selected worker
+        uint32_t responseSize = 65536; //!< Bytes sent by every selected worker
+        uint32_t queries = 100;        //!< Queries issued one after another
+        Time gap = MicroSeconds(100);  //!< Time from a completion to the next query
+        uint16_t port = 5000;          //!< Port the aggregator listens on
+    };
+
+    /**
+     * \param aggregator node issuing the queries
+     * \param address address of \p aggregator the workers connect to
+     * \param workers nodes answering the queries, each with one interface
+     * \param settings shape of the workload
+     * \param tracer traces of every worker socket, may be null
+     */
+    IncastWorkload(Ptr<Node> aggregator,
+                   Ipv4Address address,
+                   const NodeContainer& workers,
+                   const Settings& settings,
+                   Ptr<FlowTracer> tracer = nullptr);
+
+    /**
+     * \brief Connect every worker at \p start and issue the first query once
+     *        all connections are up.
+     * \param start connection time
+     */
+    void Start(Time start);
+
+    /**
+     * \return the number of queries issued so far
+     */
+    uint32_t GetIssuedCount() const;
+
+    /**
+     * \return the number of queries completed so far
+     */
+    uint32_t GetCompletedCount() const;
+
+    /**
+     * \return the number of RTOs of all worker sockets
+     */
+    uint64_t GetTimeoutCount() const;
+
+    /**
+     * \return the number of queries during which at least one RTO fired
+     */
+    uint32_t GetQueriesWithTimeout() const;
+
+    /**
+     * \return the completion times of the completed queries, in seconds
+     */
+    const LogLinearHistogram& GetQct() const;
+
+    /**
+     * \brief Write one CSV line per issued query to \p filename.
+     * \param filename output path, truncated
+     */
+    void WriteQueryStats(const std::string& filename) const;
+
+private:
+    /**
+     * Connection and progress of one worker.
+     */
+    struct Worker
+    {
+        Ptr<Node> node;       //!< Worker node
+        Ptr<Socket> socket;   //!< Connection to the aggregator
+        Ptr<Socket> accepted; //!< Aggregator side of the connection
+        uint64_t requested;   //!< Request bytes received by the worker, not yet answered
+        uint64_t pending;     //!< Response bytes not yet handed to the socket
+        uint64_t expected;    //!< Bytes the aggregator should have received in total
+        uint64_t received;    //!< Bytes the aggregator has received in total
+        bool waiting;         //!< True while the worker's response is outstanding
+    };
+
+    /**
+     * One issued query.
+     */
+    struct Query
+    {
+        Time start;        //!< Time the query was issued
+        Time completion;   //!< Completion time, negative while outstanding
+        uint32_t timeouts; //!< RTOs of worker sockets while outstanding
+    };
+
+    static void HandleAccept(IncastWorkload* workload, Ptr<Socket> socket, const Address& from);
+    static void HandleConnected(IncastWorkload* workload, Ptr<Socket> socket);
+    static void HandleConnectFailed(IncastWorkload* workload, uint32_t index, Ptr<Socket> socket);
+    static void HandleSend(IncastWorkload* workload, uint32_t index, Ptr<Socket> socket, uint32_t available);
+    static void HandleRecv(IncastWorkload* workload, uint32_t index, Ptr<Socket> socket);
+    static void HandleRequest(IncastWorkload* workload, uint32_t index, Ptr<Socket> socket);
+    static void CongStateChanged(IncastWorkload* workload,
+                                 uint32_t index,
+                                 TcpSocketState::TcpCongState_t oldValue,
+                                 TcpSocketState::TcpCongState_t newValue);
+    void Connect();
+    void IssueFirst();
+    void Issue();
+    void Fill(uint32_t index);
+
+    Ptr<Node> m_aggregator;                      //!< Node issuing the queries
+    Ipv4Address m_address;                       //!< Address the workers connect to
+    Settings m_settings;                         //!< Shape of the workload
+    Ptr<FlowTracer> m_tracer;                    //!< Worker socket traces, may be null
+    Ptr<Socket> m_listener;                      //!< Aggregator listening socket
+    std::map<Ipv4Address, uint32_t> m_byAddress; //!< Worker index by worker address
+    std::vector<Worker> m_workers;               //!< Workers in container order
+    std::vector<uint32_t> m_order;               //!< Worker indices, shuffled per query
+    Ptr<UniformRandomVariable> m_choice;         //!< Picks the workers of a query
+    std::vector<Query> m_queries;                //!< Issued queries
+    uint32_t m_connected;                        //!< Workers with an established connection
+    uint32_t m_accepted;                         //!< Connections accepted by the aggregator
+    uint32_t m_outstanding;                      //!< Responses still missing for the current query
+    uint32_t m_completed;                        //!< Completed queries
+    uint64_t m_timeouts;                         //!< RTOs of all worker sockets
+    LogLinearHistogram m_qct;                    //!< Query completion times, seconds
+};
+
+} // namespace ns3
+
+#endif // INCAST_WORKLOAD_H
@@ -0,0 +1,161 @@
+#include "log-linear-histogram.h"
+
+#include "ns3/abort.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+LogLinearHistogram::LogLinearHistogram(double unit, uint32_t subBucketBits)
+    : m_unit(unit),
+      m_subBucketBits(subBucketBits),
+      m_subBucketCount(uint64_t(1) << subBucketBits),
+      m_count(0),
+      m_sum(0.0),
+      m_min(0.0),
+      m_max(0.0)
+{
+    NS_ABORT_MSG_UNLESS(unit > 0, "Histogram unit must be positive");
+    NS_ABORT_MSG_UNLESS(subBucketBits >= 1 && subBucketBits <= 16, "Histogram sub-bucket bits out of range");
+}
+
+void LogLinearHistogram::Record(double value)
+{
+    value = std::max(0.0, value);
+
+    // 2^63 단위 이상은 마지막 버킷에 모음
+    double steps = std::min(value / m_unit + 0.5, 9.2e18);
+    uint32_t index = GetIndex(static_cast<uint64_t>(steps));
+    if (index >= m_counts.size())
+    {
+        m_counts.resize(index + 1, 0);
+    }
+    ++m_counts[index];
+
+    if (m_count == 0)
+    {
+        m_min = value;
+        m_max = value;
+    }
+    else
+    {
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+    ++m_count;
+    m_sum += value;
+}
+
+void LogLinearHistogram::Merge(const LogLinearHistogram& other)
+{
+    NS_ABORT_MSG_UNLESS(m_unit == other.m_unit && m_subBucketBits == other.m_subBucketBits,
+                        "Cannot merge histograms with different buckets");
+    if (other.m_count == 0)
+    {
+        return;
+    }
+
+    if (other.m_counts.size() > m_counts.size())
+    {
+        m_counts.resize(other.m_counts.size(), 0);
+    }
+    for (size_t i = 0; i < other.m_counts.size(); ++i)
+    {
+        m_counts[i] += other.m_counts[i];
+    }
+
+    m_min = m_count == 0 ? other.m_min : std::min(m_min, other.m_min);
+    m_max = m_count == 0 ? other.m_max : std::max(m_max, other.m_max);
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+}
+
+void LogLinearHistogram::Clear()
+{
+    m_counts.clear();
+    m_count = 0;
+    m_sum = 0.0;
+    m_min = 0.0;
+    m_max = 0.0;
+}
+
+uint64_t LogLinearHistogram::GetCount() const
+{
+    return m_count;
+}
+
+double LogLinearHistogram::GetMean() const
+{
+    return m_count > 0 ? m_sum / m_count : 0.0;
+}
+
+double LogLinearHistogram::GetMin() const
+{
+    return m_min;
+}
+
+double LogLinearHistogram::GetMax() const
+{
+    return m_max;
+}
+
+double LogLinearHistogram::GetPercentile(double fraction) const
+{
+    if (m_count == 0)
+    {
+        return 0.0;
+    }
+
+    fraction = std::min(1.0, std::max(0.0, fraction));
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * m_count)));
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < m_counts.size(); ++i)
+    {
+        seen += m_counts[i];
+        if (seen >= rank)
+        {
+            double mid = (GetLowerBound(i) + (GetWidth(i) - 1) / 2.0) * m_unit;
+            return std::min(m_max, std::max(m_min, mid));
+        }
+    }
+    return m_max;
+}
+
+uint32_t LogLinearHistogram::GetIndex(uint64_t value) const
+{
+    if (value < m_subBucketCount)
+    {
+        return static_cast<uint32_t>(value);
+    }
+
+    // 최상위 비트 아래 (m_subBucketBits - 1)비트로 옥타브 안의 위치를 정함
+    uint32_t msb = 63 - __builtin_clzll(value);
+    uint32_t shift = msb - m_subBucketBits + 1;
+    uint64_t half = m_subBucketCount / 2;
+    uint64_t sub = value >> shift;
+    return static_cast<uint32_t>(m_subBucketCount + (shift - 1) * half + (sub - half));
+}
+
+uint64_t LogLinearHistogram::GetLowerBound(uint32_t index) const
+{
+    if (index < m_subBucketCount)
+    {
+        return index;
+    }
+    uint64_t half = m_subBucketCount / 2;
+    uint64_t offset = index - m_subBucketCount;
+    uint32_t shift = offset / half + 1;
+    return (offset % half + half) << shift;
+}
+
+uint64_t LogLinearHistogram::GetWidth(uint32_t index) const
+{
+    if (index < m_subBucketCount)
+    {
+        return 1;
+    }
+    return uint64_t(1) << ((index - m_subBucketCount) / (m_subBucketCount / 2) + 1);
+}
+
+} // namespace ns3
@@ -0,0 +1,93 @@
+#ifndef LOG_LINEAR_HISTOGRAM_H
+#define LOG_LINEAR_HISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Streaming HDR-style histogram with bounded memory.
+ *
+ * Samples are quantized to integer multiples of a unit and counted in
+ * log-linear buckets: values below 2^subBucketBits units get a bucket each,
+ * and every further power of two is split into 2^(subBucketBits-1) equal
+ * buckets.  The relative error of a reported percentile is therefore below
+ * 2^-(subBucketBits-1) (under 1.6% for the default of 7 bits), whatever the
+ * number of samples.  The bucket array only grows up to the largest value
+ * seen and never beyond a few thousand counters.
+ *
+ * Count, sum, minimum and maximum are tracked exactly.
+ */
+class LogLinearHistogram
+{
+public:
+    /**
+     * \param unit size of one quantization step, in the unit of the samples
+     * \param subBucketBits log2 of the number of linear buckets per octave, 1 to 16
+     */
+    LogLinearHistogram(double unit, uint32_t subBucketBits = 7);
+
+    /**
+     * \brief Count \p value, negative values count as zero.
+     * \param value the sample
+     */
+    void Record(double value);
+
+    /**
+     * \brief Add every sample of \p other, which must use the same unit and bits.
+     * \param other histogram to merge
+     */
+    void Merge(const LogLinearHistogram& other);
+
+    /**
+     * \brief Forget every sample.
+     */
+    void Clear();
+
+    /**
+     * \return the number of samples
+     */
+    uint64_t GetCount() const;
+
+    /**
+     * \return the exact mean, 0 without samples
+     */
+    double GetMean() const;
+
+    /**
+     * \return the exact smallest sample, 0 without samples
+     */
+    double GetMin() const;
+
+    /**
+     * \return the exact largest sample, 0 without samples
+     */
+    double GetMax() const;
+
+    /**
+     * \brief Value below or at which \p fraction of the samples lie.
+     * \param fraction quantile between 0 and 1
+     * \return the midpoint of the bucket holding that sample, clamped to
+     *         [GetMin(), GetMax()], or 0 without samples
+     */
+    double GetPercentile(double fraction) const;
+
+private:
+    uint32_t GetIndex(uint64_t value) const;
+    uint64_t GetLowerBound(uint32_t index) const;
+    uint64_t GetWidth(uint32_t index) const;
+
+    double m_unit;                 //!< Sample value of one quantization step
+    uint32_t m_subBucketBits;      //!< log2 of the linear range
+    uint64_t m_subBucketCount;     //!< 2^m_subBucketBits
+    std::vector<uint64_t> m_counts; //!< Samples per bucket, grown on demand
+    uint64_t m_count;              //!< Number of samples
+    double m_sum;                  //!< Sum of samples
+    double m_min;                  //!< Smallest sample
+    double m_max;                  //!< Largest sample
+};
+
+} // namespace ns3
+
+#endif // LOG_LINEAR_HISTOGRAM_H
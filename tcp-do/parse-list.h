@@ -0,0 +1,45 @@
+#ifndef PARSE_LIST_H
+#define PARSE_LIST_H
+
+#include "ns3/abort.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Parse a comma separated command line list.
+ *
+ * Every non-empty item is read with operator>>, so any type with a stream
+ * extractor works, including Time ("5ms").  Aborts on an item that does not
+ * parse and on a list without items.
+ *
+ * \param text the list
+ * \return the items in order
+ */
+template <typename T>
+std::vector<T> ParseList(const std::string& text)
+{
+    std::vector<T> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        if (!item.empty())
+        {
+            std::stringstream field(item);
+            T value;
+            field >> value;
+            NS_ABORT_MSG_IF(field.fail(), "Cannot parse \"" << item << "\"");
+            values.push_back(value);
+        }
+    }
+    NS_ABORT_MSG_IF(values.empty(), "Empty parameter list");
+    return values;
+}
+
+} // namespace ns3
+
+#endif // PARSE_LIST_H
@@ -0,0 +1,120 @@
+#include "rtt-oscillation-estimator.h"
+
+#include <cmath> // std::abs 사용
+
+namespace ns3 {
+
+namespace {
+
+// 이 값보다 작은 RTT 변화는 진동으로 보지 않음 (초 단위)
+const double kMinRttChange = 0.0001;
+
+// 가중치 1.0 + 0.1 * age 를 정수로 다루기 위해 10배로 스케일링
+const int64_t kWeightBase = 10;
+
+} // namespace
+
+RttOscillationEstimator::RttOscillationEstimator()
+    : m_sum(0),
+      m_ageWeightedSum(0)
+{
+}
+
+void RttOscillationEstimator::Push(const Time& rtt)
+{
+    // 기존 샘플은 모두 한 칸씩 오래됨
+    m_ageWeightedSum += m_sum;
+    m_sum += rtt.GetTimeStep();
+    m_samples.PushBack(rtt);
+
+    while (!m_minWedge.Empty() && m_minWedge.Back() > rtt)
+    {
+        m_minWedge.PopBack();
+    }
+    m_minWedge.PushBack(rtt);
+
+    while (!m_maxWedge.Empty() && m_maxWedge.Back() < rtt)
+    {
+        m_maxWedge.PopBack();
+    }
+    m_maxWedge.PushBack(rtt);
+}
+
+void RttOscillationEstimator::PopOldest()
+{
+    if (m_samples.Empty())
+    {
+        return;
+    }
+
+    Time oldest = m_samples.Front();
+    int64_t oldestAge = static_cast<int64_t>(m_samples.Size()) - 1;
+    m_ageWeightedSum -= oldestAge * oldest.GetTimeStep();
+    m_sum -= oldest.GetTimeStep();
+    m_samples.PopFront();
+
+    if (m_minWedge.Front() == oldest)
+    {
+        m_minWedge.PopFront();
+    }
+    if (m_maxWedge.Front() == oldest)
+    {
+        m_maxWedge.PopFront();
+    }
+}
+
+size_t RttOscillationEstimator::GetSize() const
+{
+    return m_samples.Size();
+}
+
+double RttOscillationEstimator::Evaluate(const Time& rtt) const
+{
+    if (m_samples.Empty())
+    {
+        return 0.0;
+    }
+
+    bool allBelow = (rtt - m_maxWedge.Front()).GetSeconds() > kMinRttChange;
+    bool allAbove = (m_minWedge.Front() - rtt).GetSeconds() > kMinRttChange;
+    if (!allBelow && !allAbove)
+    {
+        // 창이 현재 RTT를 사이에 두고 있으면 부호가 섞이므로 기존 루프로 계산
+        return EvaluateByScan(rtt);
+    }
+
+    // 모든 샘플이 임계값을 넘으므로 가중치는 나이 순서 그대로 1.0, 1.1, 1.2, ...
+    int64_t n = static_cast<int64_t>(m_samples.Size());
+    int64_t weightTotal = kWeightBase * n + n * (n - 1) / 2;
+    int64_t weightedSum = kWeightBase * m_sum + m_ageWeightedSum;
+    int64_t deviation = rtt.GetTimeStep() * weightTotal - weightedSum;
+    if (allAbove)
+    {
+        deviation = -deviation;
+    }
+
+    return static_cast<double>(deviation) / weightTotal * TimeStep(1).GetSeconds();
+}
+
+double RttOscillationEstimator::EvaluateByScan(const Time& rtt) const
+{
+    double weightedOscillationSum = 0.0;
+    double weightTotal = 0.0;
+    double weight = 1.0;
+    double weightIncrement = 0.1;
+
+    for (auto it = m_samples.rbegin(); it != m_samples.rend(); ++it)
+    {
+        double rttChange = std::abs((rtt - *it).GetSeconds());
+        if (rttChange > kMinRttChange)
+        {
+            weightedOscillationSum += rttChange * weight;
+            weightTotal += weight;
+            weight += weightIncrement;
+        }
+    }
+
+    return weightTotal > 0 ? weightedOscillationSum / weightTotal : 0;
+}
+
+} // namespace ns3
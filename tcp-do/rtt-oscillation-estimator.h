@@ -0,0 +1,73 @@
+#ifndef RTT_OSCILLATION_ESTIMATOR_H
+#define RTT_OSCILLATION_ESTIMATOR_H
+
+#include "rtt-ring-buffer.h"
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+
+namespace ns3 {
+
+/**
+ * \brief Incremental estimator for the weighted RTT deviation used by TcpDo.
+ *
+ * Holds the sliding window of RTT samples used by
+ * TcpDo::CalculateOscillationFrequency together with running sums that are
+ * updated as samples enter and leave the window.  Evaluating a new sample
+ * against the window yields the same weighted mean absolute deviation as the
+ * original newest-to-oldest loop (weight 1.0 for the newest sample, +0.1 per
+ * older sample) without walking the window whenever every sample lies on the
+ * same side of the new one.  Only when the window straddles the new sample
+ * does it fall back to the exact loop.
+ */
+class RttOscillationEstimator
+{
+public:
+    RttOscillationEstimator();
+
+    /**
+     * \brief Append the newest RTT sample to the window.
+     * \param rtt the RTT sample
+     */
+    void Push(const Time& rtt);
+
+    /**
+     * \brief Drop the oldest RTT sample from the window.
+     */
+    void PopOldest();
+
+    /**
+     * \return the number of samples currently in the window
+     */
+    size_t GetSize() const;
+
+    /**
+     * \brief Weighted mean absolute deviation of \p rtt from the window.
+     *
+     * Samples closer than 0.1 ms to \p rtt are ignored and do not advance the
+     * weight, as in the original loop.
+     *
+     * \param rtt the sample to compare against the window
+     * \return the deviation in seconds, or 0 if no sample qualifies
+     */
+    double Evaluate(const Time& rtt) const;
+
+private:
+    /**
+     * \brief Exact newest-to-oldest loop, used when the fast path does not apply.
+     * \param rtt the sample to compare against the window
+     * \return the deviation in seconds
+     */
+    double EvaluateByScan(const Time& rtt) const;
+
+    RttHistory m_samples;     //!< Window, oldest first
+    RttHistory m_minWedge;    //!< Non-decreasing candidates for the window minimum
+    RttHistory m_maxWedge;    //!< Non-increasing candidates for the window maximum
+    int64_t m_sum;            //!< Sum of samples, in time steps
+    int64_t m_ageWeightedSum; //!< Sum of (age * sample), age 0 being the newest
+};
+
+} // namespace ns3
+
+#endif // RTT_OSCILLATION_ESTIMATOR_H
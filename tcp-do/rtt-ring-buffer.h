@@ -0,0 +1,227 @@
+#ifndef RTT_RING_BUFFER_H
+#define RTT_RING_BUFFER_H
+
+#include "ns3/nstime.h"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+namespace ns3 {
+
+/**
+ * \brief Fixed-capacity ring buffer for per-ACK RTT history.
+ *
+ * Storage is an inline array, so pushing and popping never touches the heap
+ * and copying a socket copies the samples in one contiguous block.  Elements
+ * are indexed oldest first; rbegin()/rend() walk them newest to oldest.
+ * Pushing into a full buffer drops the oldest element.
+ *
+ * \tparam T element type
+ * \tparam N capacity, must be a power of two
+ */
+template <typename T, size_t N>
+class RttRingBuffer
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "RttRingBuffer capacity must be a power of two");
+
+public:
+    /**
+     * \brief Read-only bidirectional iterator, oldest to newest.
+     */
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator()
+            : m_buffer(nullptr),
+              m_index(0)
+        {
+        }
+
+        ConstIterator(const RttRingBuffer* buffer, size_t index)
+            : m_buffer(buffer),
+              m_index(index)
+        {
+        }
+
+        reference operator*() const
+        {
+            return (*m_buffer)[m_index];
+        }
+
+        pointer operator->() const
+        {
+            return &(*m_buffer)[m_index];
+        }
+
+        ConstIterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator tmp = *this;
+            ++m_index;
+            return tmp;
+        }
+
+        ConstIterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        ConstIterator operator--(int)
+        {
+            ConstIterator tmp = *this;
+            --m_index;
+            return tmp;
+        }
+
+        bool operator==(const ConstIterator& other) const
+        {
+            return m_index == other.m_index && m_buffer == other.m_buffer;
+        }
+
+        bool operator!=(const ConstIterator& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        const RttRingBuffer* m_buffer;
+        size_t m_index;
+    };
+
+    using const_reverse_iterator = std::reverse_iterator<ConstIterator>;
+
+    RttRingBuffer()
+        : m_items(),
+          m_head(0),
+          m_size(0)
+    {
+    }
+
+    /**
+     * \brief Append \p item as the newest element, dropping the oldest if full.
+     * \param item the element to append
+     */
+    void PushBack(const T& item)
+    {
+        if (m_size == N)
+        {
+            PopFront();
+        }
+        m_items[(m_head + m_size) & (N - 1)] = item;
+        ++m_size;
+    }
+
+    /**
+     * \brief Remove the oldest element.  No-op on an empty buffer.
+     */
+    void PopFront()
+    {
+        if (m_size == 0)
+        {
+            return;
+        }
+        m_head = (m_head + 1) & (N - 1);
+        --m_size;
+    }
+
+    /**
+     * \brief Remove the newest element.  No-op on an empty buffer.
+     */
+    void PopBack()
+    {
+        if (m_size == 0)
+        {
+            return;
+        }
+        --m_size;
+    }
+
+    void Clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    /**
+     * \param index position counted from the oldest element
+     * \return the element at \p index
+     */
+    const T& operator[](size_t index) const
+    {
+        return m_items[(m_head + index) & (N - 1)];
+    }
+
+    const T& Front() const
+    {
+        return (*this)[0];
+    }
+
+    const T& Back() const
+    {
+        return (*this)[m_size - 1];
+    }
+
+    size_t Size() const
+    {
+        return m_size;
+    }
+
+    bool Empty() const
+    {
+        return m_size == 0;
+    }
+
+    static constexpr size_t Capacity()
+    {
+        return N;
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(this, m_size);
+    }
+
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+private:
+    std::array<T, N> m_items; //!< Inline storage
+    size_t m_head;            //!< Index of the oldest element in m_items
+    size_t m_size;            //!< Number of stored elements
+};
+
+/**
+ * RTT history used by TcpDo.  The adaptive history size is capped at 50
+ * samples and at most one extra sample is held before trimming, so 64 slots
+ * are always enough.
+ */
+typedef RttRingBuffer<Time, 64> RttHistory;
+
+} // namespace ns3
+
+#endif // RTT_RING_BUFFER_H
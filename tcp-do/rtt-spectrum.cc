@@ -0,0 +1,212 @@
+#include "rtt-spectrum.h"
+
+#include "ns3/abort.h"
+
+#include <cmath>
+
+namespace ns3 {
+
+namespace {
+
+/**
+ * cos and sin of 2 pi p / WINDOW for every phase p, shared by all spectra.
+ */
+struct TwiddleTable
+{
+    TwiddleTable()
+    {
+        for (uint32_t p = 0; p < RttSpectrum::WINDOW; ++p)
+        {
+            cos[p] = std::cos(2 * M_PI * p / RttSpectrum::WINDOW);
+            sin[p] = std::sin(2 * M_PI * p / RttSpectrum::WINDOW);
+        }
+    }
+
+    double cos[RttSpectrum::WINDOW];
+    double sin[RttSpectrum::WINDOW];
+};
+
+const TwiddleTable& GetTwiddles()
+{
+    static const TwiddleTable table;
+    return table;
+}
+
+} // namespace
+
+RttSpectrum::RttSpectrum()
+    : m_head(0),
+      m_ticks(0),
+      m_sinceRebuild(0),
+      m_period(MilliSeconds(1)),
+      m_nextTick(Time(0)),
+      m_held(0.0),
+      m_started(false)
+{
+    // 회전 계수: 빈 k = 1 .. BINS
+    const TwiddleTable& twiddles = GetTwiddles();
+    for (uint32_t k = 0; k < BINS; ++k)
+    {
+        m_cos[k / LANES][k % LANES] = twiddles.cos[k + 1];
+        m_sin[k / LANES][k % LANES] = twiddles.sin[k + 1];
+    }
+    Clear();
+}
+
+void RttSpectrum::SetSamplePeriod(Time period)
+{
+    NS_ABORT_MSG_UNLESS(period.IsStrictlyPositive(), "Spectrum sample period must be positive");
+    m_period = period;
+    Clear();
+}
+
+Time RttSpectrum::GetSamplePeriod() const
+{
+    return m_period;
+}
+
+void RttSpectrum::Clear()
+{
+    for (uint32_t i = 0; i < BINS / LANES; ++i)
+    {
+        m_re[i] = SpectrumLane{};
+        m_im[i] = SpectrumLane{};
+    }
+    for (uint32_t i = 0; i < WINDOW; ++i)
+    {
+        m_window[i] = 0.0;
+    }
+    m_head = 0;
+    m_ticks = 0;
+    m_sinceRebuild = 0;
+    m_held = 0.0;
+    m_started = false;
+}
+
+void RttSpectrum::Push(Time now, Time rtt)
+{
+    if (!m_started)
+    {
+        m_started = true;
+        m_nextTick = now;
+        m_held = rtt.GetSeconds();
+        return;
+    }
+
+    if (now >= m_nextTick)
+    {
+        int64_t count = (now - m_nextTick).GetTimeStep() / m_period.GetTimeStep() + 1;
+        if (count >= WINDOW)
+        {
+            // 공백이 창 전체보다 길면 창을 직전 값으로 채움
+            Fill(m_held);
+        }
+        else
+        {
+            for (int64_t i = 0; i < count; ++i)
+            {
+                Tick(m_held);
+            }
+        }
+        m_nextTick += TimeStep(count * m_period.GetTimeStep());
+    }
+    m_held = rtt.GetSeconds();
+}
+
+bool RttSpectrum::IsFull() const
+{
+    return m_ticks >= WINDOW;
+}
+
+void RttSpectrum::GetDominant(double& frequency, double& amplitude) const
+{
+    frequency = 0.0;
+    amplitude = 0.0;
+    if (!IsFull())
+    {
+        return;
+    }
+
+    SpectrumLane power[BINS / LANES];
+    for (uint32_t i = 0; i < BINS / LANES; ++i)
+    {
+        power[i] = m_re[i] * m_re[i] + m_im[i] * m_im[i];
+    }
+
+    uint32_t best = 0;
+    double bestPower = -1.0;
+    for (uint32_t k = 0; k < BINS; ++k)
+    {
+        double p = power[k / LANES][k % LANES];
+        if (p > bestPower)
+        {
+            bestPower = p;
+            best = k;
+        }
+    }
+
+    // 나이퀴스트 빈은 음의 주파수 짝이 없으므로 2배하지 않음
+    frequency = (best + 1) / (WINDOW * m_period.GetSeconds());
+    amplitude = (best + 1 == BINS ? 1 : 2) * std::sqrt(bestPower) / WINDOW;
+}
+
+void RttSpectrum::Tick(double value)
+{
+    double delta = value - m_window[m_head];
+    m_window[m_head] = value;
+    m_head = (m_head + 1) % WINDOW;
+    if (m_ticks < WINDOW)
+    {
+        ++m_ticks;
+    }
+
+    if (++m_sinceRebuild >= REBUILD_TICKS)
+    {
+        Rebuild();
+        return;
+    }
+
+    // 슬라이딩 DFT: 네 개의 빈을 한 번에 회전
+    for (uint32_t i = 0; i < BINS / LANES; ++i)
+    {
+        SpectrumLane re = m_re[i] + delta;
+        SpectrumLane im = m_im[i];
+        m_re[i] = m_cos[i] * re - m_sin[i] * im;
+        m_im[i] = m_sin[i] * re + m_cos[i] * im;
+    }
+}
+
+void RttSpectrum::Fill(double value)
+{
+    for (uint32_t i = 0; i < WINDOW; ++i)
+    {
+        m_window[i] = value;
+    }
+    m_head = 0;
+    m_ticks = WINDOW;
+    Rebuild();
+}
+
+void RttSpectrum::Rebuild()
+{
+    // m = 0이 가장 오래된 샘플인 창에서 X_k = sum x_m e^(-j 2 pi k m / WINDOW)
+    for (uint32_t i = 0; i < BINS / LANES; ++i)
+    {
+        m_re[i] = SpectrumLane{};
+        m_im[i] = SpectrumLane{};
+    }
+    const TwiddleTable& twiddles = GetTwiddles();
+    for (uint32_t m = 0; m < WINDOW; ++m)
+    {
+        double x = m_window[(m_head + m) % WINDOW];
+        for (uint32_t k = 0; k < BINS; ++k)
+        {
+            uint32_t phase = ((k + 1) * m) % WINDOW;
+            m_re[k / LANES][k % LANES] += x * twiddles.cos[phase];
+            m_im[k / LANES][k % LANES] -= x * twiddles.sin[phase];
+        }
+    }
+    m_sinceRebuild = 0;
+}
+
+} // namespace ns3
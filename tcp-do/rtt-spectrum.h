@@ -0,0 +1,105 @@
+#ifndef RTT_SPECTRUM_H
+#define RTT_SPECTRUM_H
+
+#include "ns3/nstime.h"
+#include "ns3/simple-ref-count.h"
+
+#include <cstdint>
+
+namespace ns3 {
+
+/**
+ * \brief Sliding spectrum of the RTT signal for spectral oscillation detection.
+ *
+ * RTT samples arrive at irregular ACK times, so the signal is first
+ * resampled onto a uniform grid of one tick per sample period by holding
+ * the latest RTT (zero-order hold).  Every tick updates the DFT bins 1 to
+ * BINS of the last WINDOW ticks with the sliding DFT recurrence
+ *
+ *   X_k <- e^(j 2 pi k / WINDOW) * (X_k + x_new - x_oldest)
+ *
+ * which costs O(BINS) per tick, not per ACK, and is computed four bins at a
+ * time with compiler vector extensions.  The bins are rebuilt exactly from
+ * the window every REBUILD_TICKS ticks to bound rounding drift.
+ *
+ * The dominant component is the non-DC bin with the most energy; its
+ * frequency is k / (WINDOW * period) and its amplitude 2 |X_k| / WINDOW,
+ * or |X_k| / WINDOW for the Nyquist bin k = WINDOW / 2, which has no
+ * mirrored negative-frequency twin.
+ *
+ * The bins take about 1.5 KB with 32-byte alignment, so TcpDoDetector
+ * allocates a spectrum only while spectral detection is on.
+ */
+class RttSpectrum : public SimpleRefCount<RttSpectrum>
+{
+public:
+    static const uint32_t WINDOW = 64;          //!< Ticks in the analysed window
+    static const uint32_t BINS = WINDOW / 2;    //!< Bins 1 .. WINDOW / 2
+    static const uint32_t REBUILD_TICKS = 1024; //!< Ticks between exact rebuilds
+
+    RttSpectrum();
+
+    /**
+     * \brief Set the resampling period and forget every sample.
+     * \param period time between ticks
+     */
+    void SetSamplePeriod(Time period);
+
+    /**
+     * \return the time between ticks
+     */
+    Time GetSamplePeriod() const;
+
+    /**
+     * \brief Forget every sample.
+     */
+    void Clear();
+
+    /**
+     * \brief Add an RTT sample taken at \p now.
+     *
+     * Emits one tick per sample period elapsed since the previous sample,
+     * each holding the previous sample's value.
+     *
+     * \param now time of the sample
+     * \param rtt the sample
+     */
+    void Push(Time now, Time rtt);
+
+    /**
+     * \return true once the window holds WINDOW ticks
+     */
+    bool IsFull() const;
+
+    /**
+     * \brief Strongest oscillation in the window.
+     * \param frequency set to its frequency in Hz, 0 until the window is full
+     * \param amplitude set to its amplitude in seconds, 0 until the window is full
+     */
+    void GetDominant(double& frequency, double& amplitude) const;
+
+private:
+    typedef double SpectrumLane __attribute__((vector_size(4 * sizeof(double))));
+    static const uint32_t LANES = 4;
+
+    void Tick(double value);
+    void Fill(double value);
+    void Rebuild();
+
+    SpectrumLane m_re[BINS / LANES];  //!< Real parts of bins 1 .. BINS
+    SpectrumLane m_im[BINS / LANES];  //!< Imaginary parts of bins 1 .. BINS
+    SpectrumLane m_cos[BINS / LANES]; //!< cos(2 pi k / WINDOW)
+    SpectrumLane m_sin[BINS / LANES]; //!< sin(2 pi k / WINDOW)
+    double m_window[WINDOW];    //!< Last WINDOW ticks, circular
+    uint32_t m_head;            //!< Oldest tick in m_window
+    uint32_t m_ticks;           //!< Ticks in the window, up to WINDOW
+    uint32_t m_sinceRebuild;    //!< Ticks since the last exact rebuild
+    Time m_period;              //!< Time between ticks
+    Time m_nextTick;            //!< Time of the next tick
+    double m_held;              //!< Value held until the next sample
+    bool m_started;             //!< True once the first sample arrived
+};
+
+} // namespace ns3
+
+#endif // RTT_SPECTRUM_H
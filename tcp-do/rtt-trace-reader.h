@@ -0,0 +1,102 @@
+#ifndef RTT_TRACE_READER_H
+#define RTT_TRACE_READER_H
+
+#include "trace-record.h"
+
+#include "ns3/abort.h"
+#include "ns3/nstime.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief One recorded RTT sample.
+ */
+struct RttSample
+{
+    Time time; //!< When the sample was taken
+    Time rtt;  //!< The sample
+};
+
+/**
+ * \brief Read the RTT samples of a recorded trace.
+ *
+ * Accepts the binary traces written by TraceSink as well as CSV files,
+ * either the two-column time,rtt files of the original scratch programs or
+ * the time,flow,kind,value output of tcp-trace-convert.  Times and RTTs in
+ * CSV files are in seconds; lines that do not parse, such as headers, are
+ * skipped.
+ *
+ * \param filename trace to read
+ * \param flowId only keep samples of this flow, negative keeps every flow
+ * \return the samples in file order
+ */
+inline std::vector<RttSample> ReadRttTrace(const std::string& filename, int64_t flowId = -1)
+{
+    std::vector<RttSample> samples;
+
+    std::FILE* in = std::fopen(filename.c_str(), "rb");
+    NS_ABORT_MSG_IF(in == nullptr, "Cannot open " << filename);
+    TraceFileHeader header;
+    bool binary = std::fread(&header, sizeof(header), 1, in) == 1 && IsValidTraceFileHeader(header);
+    if (binary)
+    {
+        std::vector<TraceRecord> records(1 << 16);
+        size_t count;
+        while ((count = std::fread(records.data(), sizeof(TraceRecord), records.size(), in)) > 0)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const TraceRecord& record = records[i];
+                if (record.kind == TRACE_RTT && (flowId < 0 || record.flowId == flowId))
+                {
+                    samples.push_back(RttSample{NanoSeconds(record.timeNs), Seconds(record.value)});
+                }
+            }
+        }
+        std::fclose(in);
+        return samples;
+    }
+    std::fclose(in);
+
+    // CSV: time,rtt 또는 time,flow,kind,value
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        std::string field;
+        while (std::getline(stream, field, ','))
+        {
+            fields.push_back(field);
+        }
+
+        char* end = nullptr;
+        double time = std::strtod(fields.empty() ? "" : fields[0].c_str(), &end);
+        if (fields.empty() || end == fields[0].c_str())
+        {
+            continue;
+        }
+        if (fields.size() == 2)
+        {
+            samples.push_back(RttSample{Seconds(time), Seconds(std::strtod(fields[1].c_str(), nullptr))});
+        }
+        else if (fields.size() == 4 && fields[2] == "rtt" &&
+                 (flowId < 0 || std::strtoll(fields[1].c_str(), nullptr, 10) == flowId))
+        {
+            samples.push_back(RttSample{Seconds(time), Seconds(std::strtod(fields[3].c_str(), nullptr))});
+        }
+    }
+    return samples;
+}
+
+} // namespace ns3
+
+#endif // RTT_TRACE_READER_H
@@ -0,0 +1,151 @@
+#ifndef RTT_WINDOW_STATISTICS_H
+#define RTT_WINDOW_STATISTICS_H
+
+#include "ns3/nstime.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace ns3 {
+
+/**
+ * \brief Online mean and population variance over a sliding RTT window.
+ *
+ * Uses Welford's update for samples entering the window and its inverse for
+ * samples leaving it, so the window can grow and shrink one sample at a time
+ * at O(1) cost.  Removal is the less stable direction, so the owner should
+ * call Rebuild() with the current window whenever NeedsRebuild() reports
+ * that enough updates have accumulated to bound the rounding drift.
+ */
+class RttWindowStatistics
+{
+public:
+    RttWindowStatistics()
+        : m_count(0),
+          m_mean(0.0),
+          m_m2(0.0),
+          m_updates(0)
+    {
+    }
+
+    /**
+     * \brief Account for a sample entering the window.
+     * \param rtt the new sample
+     */
+    void Add(const Time& rtt)
+    {
+        double x = rtt.GetSeconds();
+        ++m_count;
+        double delta = x - m_mean;
+        m_mean += delta / m_count;
+        m_m2 += delta * (x - m_mean);
+        ++m_updates;
+    }
+
+    /**
+     * \brief Account for a sample leaving the window.
+     * \param rtt the sample being removed, as previously passed to Add()
+     */
+    void Remove(const Time& rtt)
+    {
+        if (m_count <= 1)
+        {
+            Clear();
+            return;
+        }
+        double x = rtt.GetSeconds();
+        --m_count;
+        double delta = x - m_mean;
+        m_mean -= delta / m_count;
+        m_m2 -= delta * (x - m_mean);
+        if (m_m2 < 0.0)
+        {
+            m_m2 = 0.0;
+        }
+        ++m_updates;
+    }
+
+    /**
+     * \return true once enough incremental updates have been applied that the
+     *         accumulator should be recomputed from the window
+     */
+    bool NeedsRebuild() const
+    {
+        return m_updates >= REBUILD_INTERVAL;
+    }
+
+    /**
+     * \brief Recompute the statistics from scratch with a two-pass sum.
+     * \param samples the current window, any container of Time
+     */
+    template <typename Container>
+    void Rebuild(const Container& samples)
+    {
+        Clear();
+        double sum = 0.0;
+        for (const Time& rtt : samples)
+        {
+            sum += rtt.GetSeconds();
+            ++m_count;
+        }
+        if (m_count == 0)
+        {
+            return;
+        }
+        m_mean = sum / m_count;
+        for (const Time& rtt : samples)
+        {
+            double delta = rtt.GetSeconds() - m_mean;
+            m_m2 += delta * delta;
+        }
+    }
+
+    void Clear()
+    {
+        m_count = 0;
+        m_mean = 0.0;
+        m_m2 = 0.0;
+        m_updates = 0;
+    }
+
+    size_t GetCount() const
+    {
+        return m_count;
+    }
+
+    /**
+     * \return the mean RTT in seconds, 0 for an empty window
+     */
+    double GetMean() const
+    {
+        return m_mean;
+    }
+
+    /**
+     * \return the population variance in seconds squared, 0 for an empty window
+     */
+    double GetVariance() const
+    {
+        return m_count > 0 ? m_m2 / m_count : 0.0;
+    }
+
+    /**
+     * \return the population standard deviation in seconds
+     */
+    double GetStdDev() const
+    {
+        return std::sqrt(GetVariance());
+    }
+
+private:
+    static const uint32_t REBUILD_INTERVAL = 4096; //!< Updates between rebuilds
+
+    size_t m_count;     //!< Number of samples in the window
+    double m_mean;      //!< Running mean, seconds
+    double m_m2;        //!< Sum of squared deviations from the mean
+    uint32_t m_updates; //!< Incremental updates since the last rebuild
+};
+
+} // namespace ns3
+
+#endif // RTT_WINDOW_STATISTICS_H
@@ -0,0 +1,217 @@
+#include "audit-record.h"
+#include "tcp-do-detector.h"
+#include "trace-record.h"
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <vector>
+
+// Converts a decision audit file written by AuditLog (tcp-scenario --audit)
+// into CSV, one line per TcpDo window update with the branch taken, the
+// congestion signals behind it, severity, reduction factor and cwnd/ssthresh
+// before and after.
+//
+// With --trace the goodput bins of the matching binary trace are joined in:
+// goodput_before is the last bin of the flow that ended at or before the
+// decision, goodput_min_after the lowest bin ending within --window after
+// it, and goodput_dip the relative drop between the two.  Sorting by
+// goodput_dip shows which branches precede throughput dips.
+//
+//   tcp-do-audit-convert --input=audit-tcpdo-dumbbell.bin --output=audit.csv
+//   tcp-do-audit-convert --input=audit-tcpdo-dumbbell.bin --trace=trace-tcpdo-dumbbell.bin
+//                        --reductions --window=500ms
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpDoAuditConvert");
+
+namespace {
+
+/**
+ * Goodput bin of one flow.
+ */
+struct GoodputBin
+{
+    int64_t endNs; //!< End of the bin
+    double mbps;   //!< Goodput over the bin
+};
+
+typedef std::map<uint32_t, std::vector<GoodputBin>> GoodputBins;
+
+/**
+ * \brief Read the goodput bins of every flow from a binary trace.
+ */
+GoodputBins ReadGoodput(const std::string& filename)
+{
+    std::FILE* in = std::fopen(filename.c_str(), "rb");
+    NS_ABORT_MSG_IF(in == nullptr, "Cannot open " << filename);
+    TraceFileHeader header;
+    NS_ABORT_MSG_UNLESS(std::fread(&header, sizeof(header), 1, in) == 1 && IsValidTraceFileHeader(header),
+                        filename << " is not a trace file of the current format");
+
+    GoodputBins bins;
+    std::vector<TraceRecord> records(1 << 16);
+    size_t count;
+    while ((count = std::fread(records.data(), sizeof(TraceRecord), records.size(), in)) > 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (records[i].kind == TRACE_THROUGHPUT)
+            {
+                bins[records[i].flowId].push_back(GoodputBin{records[i].timeNs, records[i].value});
+            }
+        }
+    }
+    std::fclose(in);
+
+    // 구간은 플로우별로 시간 순서대로 기록되지만 이진 탐색을 위해 정렬을 보장
+    for (auto& flow : bins)
+    {
+        std::stable_sort(flow.second.begin(), flow.second.end(), [](const GoodputBin& a, const GoodputBin& b) {
+            return a.endNs < b.endNs;
+        });
+    }
+    return bins;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::string input;
+    std::string output;
+    std::string trace;
+    Time window = Seconds(1.0);
+    int64_t flow = -1;
+    bool reductions = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("input", "Binary audit file", input);
+    cmd.AddValue("output", "CSV file (default: standard output)", output);
+    cmd.AddValue("trace", "Binary trace of the same run to join goodput bins from", trace);
+    cmd.AddValue("window", "How far after a decision to look for the goodput minimum", window);
+    cmd.AddValue("flow", "Only convert records of this flow id", flow);
+    cmd.AddValue("reductions", "Only convert decisions that reduced cwnd or ssthresh", reductions);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(input.empty(), "--input is required");
+
+    std::FILE* in = std::fopen(input.c_str(), "rb");
+    NS_ABORT_MSG_IF(in == nullptr, "Cannot open " << input);
+
+    AuditFileHeader header;
+    NS_ABORT_MSG_UNLESS(std::fread(&header, sizeof(header), 1, in) == 1 && IsValidAuditFileHeader(header),
+                        input << " is not an audit file of the current format");
+
+    GoodputBins goodput;
+    if (!trace.empty())
+    {
+        goodput = ReadGoodput(trace);
+    }
+
+    std::ofstream file;
+    if (!output.empty())
+    {
+        file.open(output, std::ios::out | std::ios::trunc);
+        NS_ABORT_MSG_UNLESS(file.is_open(), "Cannot open " << output);
+    }
+    std::ostream& out = output.empty() ? std::cout : file;
+    out.precision(9);
+    out << "time,flow,decision,probe,deferred,vegas,frequency,high_rtt,retransmission,ecn,severity,reduction_factor,"
+           "oscillation,threshold,rtt_ms,rtt_threshold_ms,cwnd_before,cwnd_after,ssthresh_before,ssthresh_after";
+    if (!trace.empty())
+    {
+        out << ",goodput_before,goodput_min_after,goodput_dip";
+    }
+    out << "\n";
+
+    // 큰 블록 단위로 읽어서 변환
+    std::vector<TcpDoAuditRecord> records(1 << 16);
+    std::map<std::string, uint64_t> perDecision;
+    uint64_t converted = 0;
+    size_t count;
+    while ((count = std::fread(records.data(), sizeof(TcpDoAuditRecord), records.size(), in)) > 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const TcpDoAuditRecord& record = records[i];
+            bool reduced = record.cwndAfter < record.cwndBefore || record.ssThreshAfter < record.ssThreshBefore;
+            if ((flow >= 0 && record.flowId != flow) || (reductions && !reduced))
+            {
+                continue;
+            }
+
+            const char* decisionName = GetTcpDoDecisionName(record.decision);
+            out << record.timeNs * 1e-9 << "," << record.flowId << "," << decisionName << ","
+                << ((record.decision & TCPDO_PROBE) ? 1 : 0) << ","
+                << ((record.decision & TCPDO_DEFERRED) ? 1 : 0) << ","
+                << ((record.causes & TCPDO_CAUSE_VEGAS) ? 1 : 0) << ","
+                << ((record.causes & TCPDO_CAUSE_FREQUENCY) ? 1 : 0) << ","
+                << ((record.causes & TCPDO_CAUSE_HIGH_RTT) ? 1 : 0) << ","
+                << ((record.causes & TCPDO_CAUSE_RETRANSMISSION) ? 1 : 0) << ","
+                << ((record.causes & TCPDO_CAUSE_ECN) ? 1 : 0) << "," << record.severity << ","
+                << record.reductionFactor << "," << record.oscillation << "," << record.congestionThreshold << ","
+                << record.rtt * 1e3 << "," << record.rttThreshold * 1e3 << "," << record.cwndBefore << ","
+                << record.cwndAfter << "," << record.ssThreshBefore << "," << record.ssThreshAfter;
+
+            if (!trace.empty())
+            {
+                // 결정 직전에 끝난 구간과 이후 window 안에 끝나는 구간의 최소값을 비교
+                out << ",";
+                auto bins = goodput.find(record.flowId);
+                if (bins != goodput.end())
+                {
+                    const std::vector<GoodputBin>& flowBins = bins->second;
+                    auto after = std::upper_bound(flowBins.begin(),
+                                                  flowBins.end(),
+                                                  record.timeNs,
+                                                  [](int64_t t, const GoodputBin& bin) { return t < bin.endNs; });
+                    int64_t limit = record.timeNs + window.GetNanoSeconds();
+                    double before = after != flowBins.begin() ? std::prev(after)->mbps : -1.0;
+                    double minAfter = -1.0;
+                    for (auto it = after; it != flowBins.end() && it->endNs <= limit; ++it)
+                    {
+                        minAfter = minAfter < 0 ? it->mbps : std::min(minAfter, it->mbps);
+                    }
+                    if (before >= 0)
+                    {
+                        out << before;
+                    }
+                    out << ",";
+                    if (minAfter >= 0)
+                    {
+                        out << minAfter;
+                    }
+                    out << ",";
+                    if (before > 0 && minAfter >= 0)
+                    {
+                        out << 1.0 - minAfter / before;
+                    }
+                }
+                else
+                {
+                    out << ",,";
+                }
+            }
+            out << "\n";
+
+            ++perDecision[decisionName];
+            ++converted;
+        }
+    }
+    std::fclose(in);
+
+    std::cerr << converted << " records converted";
+    for (const auto& decision : perDecision)
+    {
+        std::cerr << ", " << decision.second << " " << decision.first;
+    }
+    std::cerr << std::endl;
+    return 0;
+}
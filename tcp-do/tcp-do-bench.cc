@@ -0,0 +1,78 @@
+#include "cc-benchmark.h"
+
+#include <cstdlib>
+#include <new>
+
+// Per-ACK cost of PktsAcked and IncreaseWindow of both TcpDo variants
+// against the stock TcpVegas, without running a simulation scenario:
+//
+//   tcp-do-bench --acks=2000000 --repeat=5 --csv=bench.csv
+//   tcp-do-bench --input=trace-tcpdo-dumbbell.bin --flow=0
+//   tcp-do-bench --baseline=bench.csv --tolerance=0.1   (exit status 1 on regression)
+//
+// The global allocation functions below replace the library ones for the
+// whole program, so that cc-benchmark.h can count heap allocations.  The
+// array and nothrow forms of the standard library forward to these.
+
+namespace ns3 {
+
+bool g_countAllocations = false;
+uint64_t g_allocations = 0;
+
+} // namespace ns3
+
+void* operator new(std::size_t size)
+{
+    if (ns3::g_countAllocations)
+    {
+        ++ns3::g_allocations;
+    }
+    void* p = std::malloc(size > 0 ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (ns3::g_countAllocations)
+    {
+        ++ns3::g_allocations;
+    }
+    // aligned_alloc은 크기가 정렬의 배수여야 함
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t rounded = (size + align - 1) / align * align;
+    void* p = std::aligned_alloc(align, rounded > 0 ? rounded : align);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+int main(int argc, char *argv[])
+{
+    return ns3::CcBenchmarkMain(argc, argv, __FILE__, "TcpDo,TcpDoV1,TcpVegas");
+}
@@ -0,0 +1,267 @@
+#include "ns3/core-module.h"
+#include "ns3/tcp-congestion-ops.h"
+#include "ns3/tcp-socket-state.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+// Behaviour checks of the TcpDo variants on a synthetic TcpSocketState,
+// driven through the TcpCongestionOps calls in the order TcpSocketBase
+// makes them, without sockets, links or packets.  Every check prints one
+// row per algorithm and the exit status is 1 if any check failed:
+//
+//   tcp-do-check
+//   tcp-do-check --algorithms=TcpDoV1 --acks=5000 --rtt=10ms
+//
+// ecn-loss: a fast retransmit or RTO while ECE is still set lowers
+// ssthresh at least as far as the same loss without ECE.  The ECE-only CWR
+// threshold is informational.
+//
+// per-rtt-growth: with PerRttGrowth and MaxRttGrowth set, cwnd grows at most
+// once per cwnd of acknowledged data and by at most MaxRttGrowth segments,
+// on a constant RTT (oscillation metric 0, so every update probes) with
+// cwnd far below ssthresh.
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpDoCheck");
+
+/**
+ * Loss or ECE event signalled by RunEcnLossEvent().
+ */
+enum EcnLossEvent
+{
+    ECN_LOSS_EVENT_LOSS,     //!< Fast retransmit with ECE clear
+    ECN_LOSS_EVENT_RECOVERY, //!< Fast retransmit with ECE set: CA_RECOVERY, then GetSsThresh()
+    ECN_LOSS_EVENT_RTO,      //!< RTO with ECE set: GetSsThresh(), then CA_LOSS
+    ECN_LOSS_EVENT_CWR,      //!< ECE without a loss: GetSsThresh(), then CA_CWR
+};
+
+/**
+ * Synthetic connection: one congestion control and its socket state.
+ */
+struct CheckFlow
+{
+    Ptr<TcpCongestionOps> cc; //!< Algorithm under check
+    Ptr<TcpSocketState> tcb;  //!< Synthetic socket state
+};
+
+// 새 인스턴스와 초기 윈도우 10 세그먼트의 소켓 상태를 생성
+CheckFlow CreateFlow(TypeId tid, uint32_t segmentSize)
+{
+    ObjectFactory factory;
+    factory.SetTypeId(tid);
+    CheckFlow flow;
+    flow.cc = factory.Create<TcpCongestionOps>();
+    NS_ABORT_MSG_UNLESS(flow.cc, tid.GetName() << " is not a congestion control");
+    flow.tcb = CreateObject<TcpSocketState>();
+    flow.tcb->m_segmentSize = segmentSize;
+    flow.tcb->m_initialCWnd = 10;
+    flow.tcb->m_cWnd = 10 * segmentSize;
+    flow.tcb->m_ssThresh = 0x7fffffff;
+    flow.tcb->m_congState = TcpSocketState::CA_OPEN;
+    return flow;
+}
+
+// 한 세그먼트를 확인하는 ACK 하나 (송신 시퀀스는 확인된 시퀀스보다 한 윈도우 앞)
+void Ack(CheckFlow* flow, Time rtt)
+{
+    Ptr<TcpSocketState> tcb = flow->tcb;
+    tcb->m_lastAckedSeq += static_cast<int32_t>(tcb->m_segmentSize);
+    tcb->m_nextTxSequence = tcb->m_lastAckedSeq + static_cast<int32_t>(tcb->m_cWnd.Get());
+    tcb->m_highTxMark = tcb->m_nextTxSequence;
+    tcb->m_bytesInFlight = tcb->m_cWnd.Get();
+    tcb->m_lastRtt = rtt;
+    flow->cc->PktsAcked(tcb, 1, rtt);
+    flow->cc->IncreaseWindow(tcb, 1);
+}
+
+// 일정한 RTT로 ACK 간격마다 하나씩, 시뮬레이터 시간을 진행시키며 처리
+void WarmUp(CheckFlow& flow, uint32_t acks, Time rtt, Time ackInterval)
+{
+    flow.cc->Init(flow.tcb);
+    flow.cc->CongestionStateSet(flow.tcb, TcpSocketState::CA_OPEN);
+    for (uint32_t i = 0; i < acks; ++i)
+    {
+        Simulator::Schedule(TimeStep(ackInterval.GetTimeStep() * (i + 1)), &Ack, &flow, rtt);
+    }
+    Simulator::Run();
+}
+
+/**
+ * \brief Warm up a fresh instance of \p tid and signal \p event.
+ *
+ * EcnMode=Dctcp and EcnGain=1 are set where the algorithm has them, so the
+ * unmarked warm-up drops the DCTCP alpha to 0 and an ECN cut alone leaves
+ * ssthresh at cwnd.
+ *
+ * \return the slow start threshold after the event
+ */
+uint32_t RunEcnLossEvent(TypeId tid, uint32_t acks, Time rtt, uint32_t segmentSize, EcnLossEvent event)
+{
+    CheckFlow flow = CreateFlow(tid, segmentSize);
+    flow.cc->SetAttributeFailSafe("EcnMode", StringValue("Dctcp"));
+    flow.cc->SetAttributeFailSafe("EcnGain", DoubleValue(1.0));
+    WarmUp(flow, acks, rtt, rtt / 10);
+
+    // TcpSocketBase와 같은 순서로 상태 변경과 GetSsThresh()를 호출
+    Ptr<TcpSocketState> tcb = flow.tcb;
+    uint32_t bytesInFlight = tcb->m_cWnd.Get();
+    if (event != ECN_LOSS_EVENT_LOSS)
+    {
+        tcb->m_ecnState = TcpSocketState::ECN_ECE_RCVD;
+    }
+    if (event == ECN_LOSS_EVENT_LOSS || event == ECN_LOSS_EVENT_RECOVERY)
+    {
+        flow.cc->CongestionStateSet(tcb, TcpSocketState::CA_RECOVERY);
+        tcb->m_congState = TcpSocketState::CA_RECOVERY;
+        tcb->m_ssThresh = flow.cc->GetSsThresh(tcb, bytesInFlight);
+    }
+    else
+    {
+        TcpSocketState::TcpCongState_t state =
+            event == ECN_LOSS_EVENT_RTO ? TcpSocketState::CA_LOSS : TcpSocketState::CA_CWR;
+        tcb->m_ssThresh = flow.cc->GetSsThresh(tcb, bytesInFlight);
+        flow.cc->CongestionStateSet(tcb, state);
+        tcb->m_congState = state;
+    }
+    uint32_t ssThresh = tcb->m_ssThresh.Get();
+    Simulator::Destroy();
+    return ssThresh;
+}
+
+/**
+ * \brief Check that a loss while ECE is still set gets at least the loss
+ *        response of \p tid.
+ *
+ * A DCTCP receiver echoes every CE mark, so ECE is often still set when a
+ * fast retransmit or RTO follows.
+ *
+ * \return true if neither loss with ECE set leaves ssthresh above the loss without
+ */
+bool CheckEcnLoss(TypeId tid, uint32_t acks, Time rtt, uint32_t segmentSize)
+{
+    uint32_t loss = RunEcnLossEvent(tid, acks, rtt, segmentSize, ECN_LOSS_EVENT_LOSS);
+    uint32_t recovery = RunEcnLossEvent(tid, acks, rtt, segmentSize, ECN_LOSS_EVENT_RECOVERY);
+    uint32_t rto = RunEcnLossEvent(tid, acks, rtt, segmentSize, ECN_LOSS_EVENT_RTO);
+    uint32_t cwr = RunEcnLossEvent(tid, acks, rtt, segmentSize, ECN_LOSS_EVENT_CWR);
+    bool passed = recovery <= loss && rto <= loss;
+    std::printf("%-10s %-16s loss %u, recovery+ece %u, rto+ece %u, cwr %u: %s\n", "ecn-loss",
+                tid.GetName().c_str() + 5, loss, recovery, rto, cwr, passed ? "ok" : "FAILED");
+    return passed;
+}
+
+/**
+ * Growth steps seen by GrowthAck().
+ */
+struct GrowthRecord
+{
+    uint64_t acked;   //!< Bytes acknowledged since the last growth step or reduction
+    uint32_t steps;   //!< ACKs that raised cwnd
+    uint32_t maxStep; //!< Largest raise of one ACK, bytes
+    uint32_t early;   //!< Raises before a cwnd of data had been acknowledged
+};
+
+// ACK 하나를 처리하고 cwnd 증가의 크기와 간격을 기록
+void GrowthAck(CheckFlow* flow, Time rtt, GrowthRecord* record)
+{
+    uint32_t before = flow->tcb->m_cWnd.Get();
+    Ack(flow, rtt);
+    uint32_t after = flow->tcb->m_cWnd.Get();
+    record->acked += flow->tcb->m_segmentSize;
+    if (after > before)
+    {
+        // 크레딧의 나머지는 한 세그먼트 미만이므로 그만큼은 허용
+        if (record->acked + flow->tcb->m_segmentSize <= before)
+        {
+            ++record->early;
+        }
+        record->maxStep = std::max(record->maxStep, after - before);
+        ++record->steps;
+        record->acked = 0;
+    }
+    else if (after < before)
+    {
+        record->acked = 0;
+    }
+}
+
+/**
+ * \brief Check that PerRttGrowth holds every raise of cwnd of \p tid to one
+ *        capped step per cwnd of acknowledged data.
+ *
+ * The RTT is constant, so the oscillation metric stays 0 and every update
+ * probes, and ssthresh stays far above cwnd.  Algorithms without
+ * PerRttGrowth are skipped.
+ *
+ * \return true if no raise came early or exceeded MaxRttGrowth
+ */
+bool CheckPerRttGrowth(TypeId tid, uint32_t acks, Time rtt, uint32_t segmentSize)
+{
+    const uint32_t maxRttGrowth = 2;
+    CheckFlow flow = CreateFlow(tid, segmentSize);
+    if (!flow.cc->SetAttributeFailSafe("PerRttGrowth", BooleanValue(true)) ||
+        !flow.cc->SetAttributeFailSafe("MaxRttGrowth", UintegerValue(maxRttGrowth)))
+    {
+        std::printf("%-10s %-16s no PerRttGrowth: skipped\n", "per-rtt-growth", tid.GetName().c_str() + 5);
+        return true;
+    }
+
+    GrowthRecord record = {0, 0, 0, 0};
+    flow.cc->Init(flow.tcb);
+    flow.cc->CongestionStateSet(flow.tcb, TcpSocketState::CA_OPEN);
+    Time ackInterval = rtt / 10;
+    for (uint32_t i = 0; i < acks; ++i)
+    {
+        Simulator::Schedule(TimeStep(ackInterval.GetTimeStep() * (i + 1)), &GrowthAck, &flow, rtt, &record);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    bool passed = record.steps > 0 && record.early == 0 && record.maxStep <= maxRttGrowth * segmentSize;
+    std::printf("%-10s %-16s %u steps, largest %.2f segments, %u early: %s\n", "per-rtt-growth",
+                tid.GetName().c_str() + 5, record.steps, static_cast<double>(record.maxStep) / segmentSize,
+                record.early, passed ? "ok" : "FAILED");
+    return passed;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string algorithms = "TcpDo,TcpDoV1";
+    uint32_t acks = 1000;
+    Time rtt = MilliSeconds(50);
+    uint32_t segmentSize = 1448;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("algorithms", "Comma separated congestion controls to check", algorithms);
+    cmd.AddValue("acks", "ACKs of the warm-up before each event", acks);
+    cmd.AddValue("rtt", "RTT of every warm-up sample", rtt);
+    cmd.AddValue("segmentSize", "Segment size of the synthetic socket", segmentSize);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(acks == 0, "--acks must be positive");
+    NS_ABORT_MSG_UNLESS(rtt.IsStrictlyPositive(), "--rtt must be positive");
+
+    int status = 0;
+    std::stringstream list(algorithms);
+    std::string name;
+    while (std::getline(list, name, ','))
+    {
+        if (name.find("ns3::") != 0)
+        {
+            name = "ns3::" + name;
+        }
+        TypeId tid;
+        NS_ABORT_MSG_UNLESS(TypeId::LookupByNameFailSafe(name, &tid), "Unknown algorithm: " << name);
+        if (!CheckEcnLoss(tid, acks, rtt, segmentSize))
+        {
+            status = 1;
+        }
+        if (!CheckPerRttGrowth(tid, acks, rtt, segmentSize))
+        {
+            status = 1;
+        }
+    }
+    return status;
+}
@@ -0,0 +1,768 @@
+#include "tcp-do-detector.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm> // std::max 사용
+#include <cmath>
+
+// 정책 클래스는 검출기 템플릿과 같은 번역 단위에서 정의하여
+// 명시적 인스턴스화 시 ACK 경로에 인라인되도록 함
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("TcpDoDetector");
+
+const char* GetTcpDoDecisionName(uint8_t decision)
+{
+    switch (decision & ~(TCPDO_PROBE | TCPDO_DEFERRED))
+    {
+    case TCPDO_REDUCE_DELAY:
+        return "reduce-delay";
+    case TCPDO_REDUCE_FREQUENCY:
+        return "reduce-frequency";
+    case TCPDO_GROW_FAST:
+        return "grow-fast";
+    case TCPDO_SHRINK:
+        return "shrink";
+    case TCPDO_GROW_MODERATE:
+        return "grow-moderate";
+    case TCPDO_BACKOFF:
+        return "backoff";
+    default:
+        return "unknown";
+    }
+}
+
+TcpDoMetricSettings::TcpDoMetricSettings(Time timeWindow, size_t historySize)
+    : m_timeWindow(timeWindow),
+      m_rttHistorySize(historySize),
+      m_minRttHistorySize(10),
+      m_maxRttHistorySize(50)
+{
+}
+
+void TcpDoMetricSettings::SetTimeWindow(Time window)
+{
+    m_timeWindow = window;
+}
+
+Time TcpDoMetricSettings::GetTimeWindow() const
+{
+    return m_timeWindow;
+}
+
+void TcpDoMetricSettings::SetRttHistoryBounds(size_t minSize, size_t maxSize)
+{
+    NS_ABORT_MSG_UNLESS(minSize >= 1 && minSize <= maxSize, "Invalid RTT history bounds");
+    NS_ABORT_MSG_UNLESS(maxSize < RttHistory::Capacity(),
+                        "RTT history bound must stay below " << RttHistory::Capacity());
+    m_minRttHistorySize = minSize;
+    m_maxRttHistorySize = maxSize;
+    m_rttHistorySize = std::min(maxSize, std::max(minSize, m_rttHistorySize));
+}
+
+size_t TcpDoMetricSettings::GetMinRttHistorySize() const
+{
+    return m_minRttHistorySize;
+}
+
+size_t TcpDoMetricSettings::GetMaxRttHistorySize() const
+{
+    return m_maxRttHistorySize;
+}
+
+size_t TcpDoMetricSettings::GetRttHistorySize() const
+{
+    return m_rttHistorySize;
+}
+
+void TcpDoMetricSettings::AdaptRttHistorySize(bool congested)
+{
+    // 혼잡 감지 시 샘플 크기 증가, 안정적인 경우 샘플 크기 감소
+    if (congested)
+    {
+        m_rttHistorySize = std::min(m_maxRttHistorySize, m_rttHistorySize + 1);
+    }
+    else
+    {
+        m_rttHistorySize = std::max(m_minRttHistorySize, m_rttHistorySize - 1);
+    }
+}
+
+TcpDoWindowedDeviation::TcpDoWindowedDeviation()
+    : TcpDoMetricSettings(Seconds(0.01), 20),
+      m_oscillation(0.0),
+      m_oscillationCount(0),
+      m_lastCalculationTime(Time(0.0)),
+      m_prevRtt(Time(0))
+{
+}
+
+void TcpDoWindowedDeviation::OnRtt(Time now, Time rtt, double congestionThreshold)
+{
+    Time currentRtt = rtt;
+
+    // RTT 변화 감지
+    if (m_prevRtt != Time(0))
+    {
+        double rttChange = (currentRtt - m_prevRtt).GetSeconds();
+        if (std::abs(rttChange) > 0.0001)
+        {
+            // 변화가 발생할 때마다 진동 수를 증가
+            m_oscillationCount++;
+        }
+    }
+
+    m_prevRtt = currentRtt;
+
+    // 일정 시간 창(window) 동안의 진동 수를 계산
+    if (now - m_lastCalculationTime >= m_timeWindow)
+    {
+        // 가중치를 적용한 진동수 계산 (누적 합으로 증분 계산)
+        m_oscillation = m_rttHistory.Evaluate(currentRtt);
+
+        // 다음 계산을 위해 초기화
+        m_oscillationCount = 0;
+        m_lastCalculationTime = now;
+    }
+
+    m_rttHistory.Push(rtt);
+    if (m_rttHistory.GetSize() > m_rttHistorySize)
+    {
+        m_rttHistory.PopOldest();
+    }
+
+    AdaptRttHistorySize(m_oscillation > congestionThreshold);
+}
+
+TcpDoPerAckDeviation::TcpDoPerAckDeviation()
+    : TcpDoMetricSettings(Seconds(0.1), 30),
+      m_oscillation(0.0),
+      m_oscillationCount(0),
+      m_windowStartTime(Time(0)),
+      m_prevRtt(Time(0))
+{
+}
+
+void TcpDoPerAckDeviation::OnRtt(Time now, Time rtt, double congestionThreshold)
+{
+    Time currentRtt = rtt;
+
+    if (m_prevRtt != Time(0))
+    {
+        double rttChange = (currentRtt - m_prevRtt).GetSeconds();
+        if (std::abs(rttChange) > 0.00001)
+        {
+            m_oscillationCount++;
+        }
+    }
+    else
+    {
+        // 첫 RTT 샘플 시점부터 시간 창을 시작
+        m_windowStartTime = now;
+    }
+
+    m_prevRtt = currentRtt;
+
+    if (now - m_windowStartTime >= m_timeWindow)
+    {
+        m_oscillation = static_cast<double>(m_oscillationCount) / m_timeWindow.GetSeconds();
+        m_oscillationCount = 0;
+        m_windowStartTime = now;
+    }
+
+    AdaptRttHistorySize(m_oscillation > congestionThreshold);
+
+    m_rttHistory.PushBack(rtt);
+    if (m_rttHistory.Size() > m_rttHistorySize)
+    {
+        m_rttHistory.PopFront();
+    }
+
+    if (m_rttHistory.Size() < 2)
+    {
+        return;
+    }
+
+    double weightedSum = 0.0;
+    double weightTotal = 0.0;
+    double weight = 1.0;
+    double weightIncrement = 0.2;
+
+    for (auto it = m_rttHistory.rbegin(); it != m_rttHistory.rend(); ++it)
+    {
+        weightedSum += it->GetSeconds() * weight;
+        weightTotal += weight;
+        weight += weightIncrement;
+    }
+
+    double weightedAverageRtt = weightedSum / weightTotal;
+    m_oscillation = std::abs(currentRtt.GetSeconds() - weightedAverageRtt);
+}
+
+void TcpDoRttSpreadRule::OnRtt(Time rtt, size_t windowSize)
+{
+    m_window.PushBack(rtt);
+    m_stats.Add(rtt);
+
+    if (m_window.Size() > windowSize)
+    {
+        m_stats.Remove(m_window.Front());
+        m_window.PopFront();
+    }
+
+    // 누적 오차를 막기 위해 주기적으로 창 전체에서 다시 계산
+    if (m_stats.NeedsRebuild())
+    {
+        m_stats.Rebuild(m_window);
+    }
+}
+
+TcpDoWindowRule::TcpDoWindowRule()
+    : m_cachedOscillation(0.0),
+      m_lastIncreaseTime(Time(0))
+{
+}
+
+uint8_t TcpDoWindowRule::Update(Time now,
+                                Time timeWindow,
+                                double oscillation,
+                                bool rttAboveThreshold,
+                                double& congestionThreshold,
+                                TcpDoWindow& window,
+                                TcpDoDecisionDetail& detail)
+{
+    // 진동수 계산 주기가 지나면 소켓별 캐시 값을 갱신
+    if (now - m_lastIncreaseTime >= timeWindow)
+    {
+        m_cachedOscillation = oscillation;
+        m_lastIncreaseTime = now; // 마지막 계산 시간 갱신
+    }
+
+    bool vegasDetectedCongestion = (window.cWnd > window.ssThresh);
+    double currentOscillationFrequency = m_cachedOscillation; // 이전 계산된 진동수 사용
+    bool frequencyDetectedCongestion = (currentOscillationFrequency > congestionThreshold);
+
+    detail.causes = (vegasDetectedCongestion ? TCPDO_CAUSE_VEGAS : 0) |
+                    (frequencyDetectedCongestion ? TCPDO_CAUSE_FREQUENCY : 0) |
+                    (rttAboveThreshold ? TCPDO_CAUSE_HIGH_RTT : 0);
+    detail.oscillation = currentOscillationFrequency;
+    detail.congestionThreshold = congestionThreshold;
+    detail.severity = 0.0;
+    detail.reductionFactor = 1.0;
+
+    if (vegasDetectedCongestion || frequencyDetectedCongestion || rttAboveThreshold)
+    {
+        NS_LOG_INFO("Congestion detected by Vegas, Oscillation Frequency, or High RTT: Reducing cwnd");
+
+        uint32_t newCwnd;
+        uint8_t decision;
+        double severity = currentOscillationFrequency / congestionThreshold;
+
+        if (vegasDetectedCongestion || rttAboveThreshold)
+        {
+            // Vegas나 RTT 기반 혼잡 감지의 경우 약간 덜 공격적으로 감소
+            double reductionFactor = std::max(0.8, 1.0 - severity * 0.05);  // 혼잡이 심할수록 줄임 (최소 70%)
+            newCwnd = std::max(static_cast<uint32_t>(window.cWnd * reductionFactor), window.segmentSize * 10);
+            decision = TCPDO_REDUCE_DELAY;
+            detail.reductionFactor = reductionFactor;
+        }
+        else
+        {
+            // 진동수 기반 혼잡 감지의 경우 더 강하게 감소
+            double reductionFactor = std::max(0.7, 1.0 - severity * 0.15);  // 혼잡이 심할수록 더 줄임 (최소 50%)
+            newCwnd = std::max(static_cast<uint32_t>(window.cWnd * reductionFactor), window.segmentSize * 10);
+            decision = TCPDO_REDUCE_FREQUENCY;
+            detail.reductionFactor = reductionFactor;
+        }
+
+        // 혼잡 후 빠르게 회복하기 위해 임계값을 일시적으로 증가
+        congestionThreshold *= std::min(2.0, 1.0 + severity * 0.2);
+        detail.severity = severity;
+
+        window.ssThresh = newCwnd;  // 혼잡 후 바로 선형 증가 모드로 진입
+        window.cWnd = newCwnd;
+        return decision;
+    }
+
+    NS_LOG_INFO("No congestion detected: Increasing cwnd cautiously");
+
+    uint8_t probe = 0;
+    if (currentOscillationFrequency == 0.0)
+    {
+        window.cWnd += window.segmentSize * 15;  // 더 공격적인 변동 유도
+        congestionThreshold *= 0.9;
+        probe = TCPDO_PROBE;
+        NS_LOG_INFO("Reducing congestion threshold temporarily to induce change");
+    }
+
+    double alpha = 1.0;
+    double beta = 3.0;
+
+    // cWnd < ssThresh이면 부호 없는 뺄셈이 감싸져 큰 값이 됨 (원래 동작 유지)
+    double diff = (window.cWnd - window.ssThresh) / window.segmentSize;
+
+    if (diff < alpha)
+    {
+        window.cWnd += window.segmentSize * 7;
+        NS_LOG_INFO("Minimal congestion detected: Slowly increasing cwnd by four segments");
+        return TCPDO_GROW_FAST | probe;
+    }
+    if (diff > beta)
+    {
+        window.cWnd -= window.segmentSize;
+        NS_LOG_INFO("Heavy congestion detected: Decreasing cwnd by one segment");
+        return TCPDO_SHRINK | probe;
+    }
+
+    uint32_t maxIncrease = std::max(1U, window.cWnd / 2);
+    window.cWnd = std::min(window.cWnd + maxIncrease, window.ssThresh);
+    NS_LOG_INFO("Moderate congestion detected: Increasing cwnd moderately");
+    return TCPDO_GROW_MODERATE | probe;
+}
+
+uint8_t TcpDoV1WindowRule::Update(Time /* now */,
+                                  Time /* timeWindow */,
+                                  double oscillation,
+                                  bool rttAboveThreshold,
+                                  double& congestionThreshold,
+                                  TcpDoWindow& window,
+                                  TcpDoDecisionDetail& detail)
+{
+    congestionThreshold *= 1.01;
+
+    bool vegasDetectedCongestion = (window.cWnd > window.ssThresh);
+    double currentOscillationFrequency = oscillation;
+    bool frequencyDetectedCongestion = (currentOscillationFrequency > congestionThreshold);
+
+    detail.causes = (vegasDetectedCongestion ? TCPDO_CAUSE_VEGAS : 0) |
+                    (frequencyDetectedCongestion ? TCPDO_CAUSE_FREQUENCY : 0) |
+                    (rttAboveThreshold ? TCPDO_CAUSE_HIGH_RTT : 0);
+    detail.oscillation = currentOscillationFrequency;
+    detail.congestionThreshold = congestionThreshold;
+    detail.severity = 0.0;
+    detail.reductionFactor = 1.0;
+
+    if (vegasDetectedCongestion || frequencyDetectedCongestion || rttAboveThreshold)
+    {
+        double severity = currentOscillationFrequency / congestionThreshold;
+
+        double reductionFactor = std::max(0.7, 1.0 - severity * 0.1);
+        double recoveryFactor = std::min(1.5, 1.0 + severity * 0.2);
+
+        uint32_t newCwnd = std::max(static_cast<uint32_t>(window.cWnd * reductionFactor), window.segmentSize * 10);
+        congestionThreshold *= recoveryFactor;
+        detail.severity = severity;
+        detail.reductionFactor = reductionFactor;
+
+        window.ssThresh = newCwnd;
+        window.cWnd = newCwnd;
+        // v1은 감소 방식이 하나뿐이며, 원인만 구분하여 보고
+        return (vegasDetectedCongestion || rttAboveThreshold) ? TCPDO_REDUCE_DELAY : TCPDO_REDUCE_FREQUENCY;
+    }
+
+    uint8_t probe = 0;
+    double lowOscillationThreshold = 0.00001;
+    if (currentOscillationFrequency <= lowOscillationThreshold)
+    {
+        window.cWnd += window.segmentSize * 7;
+        congestionThreshold *= 0.98;
+        probe = TCPDO_PROBE;
+    }
+
+    double alpha = 0.5;
+    double beta = 2.0;
+
+    // cWnd < ssThresh이면 부호 없는 뺄셈이 감싸져 큰 값이 됨 (원래 동작 유지)
+    double diff = (window.cWnd - window.ssThresh) / window.segmentSize;
+
+    if (diff < alpha)
+    {
+        window.cWnd += window.segmentSize * 6;
+        return TCPDO_GROW_FAST | probe;
+    }
+    if (diff > beta)
+    {
+        window.cWnd -= window.segmentSize * 3;
+        return TCPDO_SHRINK | probe;
+    }
+
+    uint32_t maxIncrease = std::max(1U, window.cWnd / 2);
+    window.cWnd = std::min(window.cWnd + maxIncrease, window.ssThresh);
+    return TCPDO_GROW_MODERATE | probe;
+}
+
+bool TcpDoRttLossResponse::GetSsThresh(double currentRtt,
+                                       double referenceRtt,
+                                       const TcpDoWindow& window,
+                                       uint32_t& ssThresh,
+                                       TcpDoDecisionDetail& detail)
+{
+    detail.severity = 0.0;
+    if (currentRtt > referenceRtt)
+    {
+        // 지연이 늘어난 상태의 손실은 혼잡으로 보고 크게 줄임
+        NS_LOG_INFO("Loss with RTT above the reference: congestion");
+        ssThresh = std::max(static_cast<uint32_t>(window.cWnd / 1.5), 2 * window.segmentSize);
+        detail.causes = TCPDO_CAUSE_RETRANSMISSION | TCPDO_CAUSE_HIGH_RTT;
+        detail.reductionFactor = 1 / 1.5;
+    }
+    else
+    {
+        // 지연 증가 없는 손실은 임의 손실로 보고 조금만 줄임
+        NS_LOG_INFO("Loss without RTT increase: random loss");
+        ssThresh = std::max(static_cast<uint32_t>(window.cWnd / 1.1), 2 * window.segmentSize);
+        detail.causes = TCPDO_CAUSE_RETRANSMISSION;
+        detail.reductionFactor = 1 / 1.1;
+    }
+    return true;
+}
+
+TcpDoEcnResponse::TcpDoEcnResponse()
+    : m_mode(TCPDO_ECN_OFF),
+      m_gain(1.0 / 16),
+      m_alpha(1.0), // DCTCP처럼 첫 표시에는 절반으로 줄임
+      m_ackedBytes(0),
+      m_markedBytes(0)
+{
+}
+
+void TcpDoEcnResponse::SetMode(TcpDoEcnMode mode)
+{
+    m_mode = mode;
+}
+
+TcpDoEcnMode TcpDoEcnResponse::GetMode() const
+{
+    return m_mode;
+}
+
+void TcpDoEcnResponse::SetGain(double gain)
+{
+    NS_ABORT_MSG_UNLESS(gain > 0 && gain <= 1, "ECN gain must be in (0, 1]");
+    m_gain = gain;
+}
+
+double TcpDoEcnResponse::GetGain() const
+{
+    return m_gain;
+}
+
+double TcpDoEcnResponse::GetAlpha() const
+{
+    return m_alpha;
+}
+
+void TcpDoEcnResponse::OnAck(uint32_t bytesAcked, bool marked)
+{
+    m_ackedBytes += bytesAcked;
+    if (marked)
+    {
+        m_markedBytes += bytesAcked;
+    }
+}
+
+void TcpDoEcnResponse::EndWindow()
+{
+    if (m_ackedBytes == 0)
+    {
+        return;
+    }
+    double fraction = static_cast<double>(m_markedBytes) / m_ackedBytes;
+    m_alpha = (1 - m_gain) * m_alpha + m_gain * fraction;
+    m_ackedBytes = 0;
+    m_markedBytes = 0;
+}
+
+void TcpDoEcnResponse::GetSsThresh(const TcpDoWindow& window, uint32_t& ssThresh, TcpDoDecisionDetail& detail) const
+{
+    // 고전 ECN은 손실과 같이 절반, DCTCP 방식은 표시 비율에 비례해 줄임
+    double factor = m_mode == TCPDO_ECN_DCTCP ? 1.0 - m_alpha / 2 : 0.5;
+    ssThresh = std::max(static_cast<uint32_t>(window.cWnd * factor), 2 * window.segmentSize);
+    detail.causes = TCPDO_CAUSE_ECN;
+    detail.severity = 0.0;
+    detail.reductionFactor = factor;
+}
+
+template <typename Policies>
+TcpDoDetector<Policies>::TcpDoDetector()
+    : m_congestionThreshold(0.001),
+      m_baseRtt(Time(0.0)),
+      m_spectralDetection(false),
+      m_spectralSamplePeriod(MilliSeconds(1)),
+      m_spectralAmplitude(0.0),
+      m_dominantFrequency(0.0),
+      m_lastSpectrumTime(Time(0)),
+      m_perRttGrowth(false),
+      m_growthScale(1.0),
+      m_maxRttGrowth(0),
+      m_growthCredit(0)
+{
+}
+
+template <typename Policies>
+TcpDoDetector<Policies>::TcpDoDetector(const TcpDoDetector& other)
+    : m_congestionThreshold(other.m_congestionThreshold),
+      m_baseRtt(other.m_baseRtt),
+      m_metric(other.m_metric),
+      m_rttRule(other.m_rttRule),
+      m_windowRule(other.m_windowRule),
+      m_spectralDetection(other.m_spectralDetection),
+      m_spectralSamplePeriod(other.m_spectralSamplePeriod),
+      m_spectralAmplitude(other.m_spectralAmplitude),
+      m_dominantFrequency(other.m_dominantFrequency),
+      m_lastSpectrumTime(other.m_lastSpectrumTime),
+      m_perRttGrowth(other.m_perRttGrowth),
+      m_growthScale(other.m_growthScale),
+      m_maxRttGrowth(other.m_maxRttGrowth),
+      m_growthCredit(other.m_growthCredit)
+{
+    // 스펙트럼은 공유하지 않고 복제
+    if (other.m_spectrum)
+    {
+        m_spectrum = Create<RttSpectrum>(*other.m_spectrum);
+    }
+}
+
+template <typename Policies>
+void TcpDoDetector<Policies>::SetCongestionThreshold(double threshold)
+{
+    m_congestionThreshold = threshold;
+}
+
+template <typename Policies>
+double TcpDoDetector<Policies>::GetCongestionThreshold() const
+{
+    return m_congestionThreshold;
+}
+
+template <typename Policies>
+void TcpDoDetector<Policies>::SetTimeWindow(Time window)
+{
+    m_metric.SetTimeWindow(window);
+}
+
+template <typename Policies>
+Time TcpDoDetector<Policies>::GetTimeWindow() const
+{
+    return m_metric.GetTimeWindow();
+}
+
+template <typename Policies>
+void TcpDoDetector<Policies>::SetRttHistoryBounds(size_t minSize, size_t maxSize)
+{
+    m_metric.SetRttHistoryBounds(minSize, maxSize);
+}
+
+template <typename Policies>
+size_t TcpDoDetector<Policies>::GetMinRttHistorySize() const
+{
+    return m_metric.GetMinRttHistorySize();
+}
+
+template <typename Policies>
+size_t TcpDoDetector<Policies>::GetMaxRttHistorySize() const
+{
+    return m_metric.GetMaxRttHistorySize();
+}
+
+template <typename Policies>
+size_t TcpDoDetector<Policies>::GetRttHistorySize() const
+{
+    return m_metric.GetRttHistorySize();
+}
+
+template <typename Policies>
+void TcpDoDetector<Policies>::SetSpectralDetection(bool enable)
+{
+    // 스펙트럼 모드에서만 스펙트럼을 할당
+    m_spectralDetection = enable;
+    m_spectrum = nullptr;
+    if (enable)
+    {
+        m_spectrum = Create<RttSpectrum>();
+        m_spectrum->SetSamplePeriod(m_spectralSamplePeriod);
+    }
+    m_spectralAmplitude = 0.0;
+    m_dominantFrequency = 0.0;
+}
+
+template <typename Policies>
+bool TcpDoDetector<Policies>::IsSpectralDetection() const
+{
+    return m_spectralDetection;
+}
+
+template <typename Policies>
+void TcpDoDetector<Policies>::SetSpectralSamplePeriod(Time period)
+{
+    NS_ABORT_MSG_UNLESS(period.IsStrictlyPositive(), "Spectrum sample period must be positive");
+    m_spectralSamplePeriod = period;
+    if (m_spectrum)
+    {
+        m_spectrum->SetSamplePeriod(period);
+    }
+}
+
+template <typename Policies>
+Time TcpDoDetector<Policies>::GetSpectralSamplePeriod() const
+{
+    return m_spectralSamplePeriod;
+}
+
+template <typename Policies>
+double TcpDoDetector<Policies>::GetLastOscillationFrequency() const
+{
+    return m_spectralDetection ? m_spectralAmplitude : m_metric.GetOscillation();
+}
+
+template <typename Policies>
+double TcpDoDetector<Policies>::GetDominantFrequency() const
+{
+    return m_dominantFrequency;
+}
+
+template <typename Policies>
+void TcpDoDetector<Policies>::SetPerRttGrowth(bool enable)
+{
+    m_perRttGrowth = enable;
+    m_growthCredit = 0;
+}
+
+template <typename Policies>
+bool TcpDoDetector<Policies>::IsPerRttGrowth() const
+{
+    return m_perRttGrowth;
+}
+
+template <typename Policies>
+void TcpDoDetector<Policies>::SetGrowthScale(double scale)
+{
+    NS_ABORT_MSG_IF(scale < 0, "Growth scale must not be negative");
+    m_growthScale = scale;
+}
+
+template <typename Policies>
+double TcpDoDetector<Policies>::GetGrowthScale() const
+{
+    return m_growthScale;
+}
+
+template <typename Policies>
+void TcpDoDetector<Policies>::SetMaxRttGrowth(uint32_t segments)
+{
+    m_maxRttGrowth = segments;
+}
+
+template <typename Policies>
+uint32_t TcpDoDetector<Policies>::GetMaxRttGrowth() const
+{
+    return m_maxRttGrowth;
+}
+
+template <typename Policies>
+Time TcpDoDetector<Policies>::GetBaseRtt() const
+{
+    return m_baseRtt;
+}
+
+template <typename Policies>
+double TcpDoDetector<Policies>::GetReferenceRtt() const
+{
+    return m_rttRule.GetReference(m_baseRtt);
+}
+
+template <typename Policies>
+double TcpDoDetector<Policies>::GetRttThreshold() const
+{
+    return m_rttRule.GetThreshold(m_baseRtt);
+}
+
+template <typename Policies>
+void TcpDoDetector<Policies>::OnRtt(Time now, Time rtt)
+{
+    // 최소 RTT 갱신
+    if (m_baseRtt == Time(0.0) || rtt < m_baseRtt)
+    {
+        m_baseRtt = rtt;
+    }
+
+    if (m_spectralDetection)
+    {
+        // 스펙트럼 모드: 지배적 진동의 진폭을 혼잡 지표로 사용 (RTT 이력은 사용하지 않음)
+        m_spectrum->Push(now, rtt);
+        if (now - m_lastSpectrumTime >= m_metric.GetTimeWindow())
+        {
+            m_spectrum->GetDominant(m_dominantFrequency, m_spectralAmplitude);
+            m_lastSpectrumTime = now;
+        }
+    }
+    else
+    {
+        m_metric.OnRtt(now, rtt, m_congestionThreshold);
+    }
+
+    m_rttRule.OnRtt(rtt, m_metric.GetRttHistorySize());
+}
+
+template <typename Policies>
+uint8_t TcpDoDetector<Policies>::UpdateWindow(Time now,
+                                              Time lastRtt,
+                                              uint32_t segmentsAcked,
+                                              TcpDoWindow& window,
+                                              TcpDoDecisionDetail& detail)
+{
+    bool rttAboveThreshold = lastRtt.GetSeconds() > GetRttThreshold();
+    TcpDoWindow before = window;
+    double thresholdBefore = m_congestionThreshold;
+    uint8_t decision = m_windowRule.Update(now,
+                                           m_metric.GetTimeWindow(),
+                                           GetLastOscillationFrequency(),
+                                           rttAboveThreshold,
+                                           m_congestionThreshold,
+                                           window,
+                                           detail);
+    if (!m_perRttGrowth)
+    {
+        return decision;
+    }
+
+    // 감소는 분기가 아니라 결과로 판단: PROBE와 겹친 SHRINK처럼 순증가하면 크레딧을 거침
+    if (window.cWnd < before.cWnd || window.ssThresh != before.ssThresh)
+    {
+        m_growthCredit = 0;
+        return decision;
+    }
+
+    // 확인된 바이트가 한 윈도우에 이를 때까지 증가 단계를 보류
+    m_growthCredit += static_cast<uint64_t>(segmentsAcked) * before.segmentSize;
+    if (m_growthCredit < before.cWnd)
+    {
+        window = before;
+        m_congestionThreshold = thresholdBefore;
+        return decision | TCPDO_DEFERRED;
+    }
+    m_growthCredit -= before.cWnd;
+    if (m_growthCredit >= before.cWnd)
+    {
+        // 한 번의 ACK가 여러 윈도우를 확인해도 증가는 한 단계만 적용
+        m_growthCredit = 0;
+    }
+
+    if (window.cWnd > before.cWnd)
+    {
+        double step = (window.cWnd - before.cWnd) * m_growthScale;
+        if (m_maxRttGrowth > 0)
+        {
+            step = std::min(step, static_cast<double>(m_maxRttGrowth) * before.segmentSize);
+        }
+        window.cWnd = before.cWnd + static_cast<uint32_t>(step);
+    }
+    return decision;
+}
+
+template class TcpDoDetector<TcpDoPolicies>;
+template class TcpDoDetector<TcpDoV1Policies>;
+
+} // namespace ns3
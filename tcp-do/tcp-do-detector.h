@@ -0,0 +1,258 @@
+#ifndef TCP_DO_DETECTOR_H
+#define TCP_DO_DETECTOR_H
+
+#include "rtt-spectrum.h"
+#include "tcp-do-policies.h"
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+
+namespace ns3 {
+
+/**
+ * \brief Window branch taken by TcpDoDetector::UpdateWindow(), or
+ *        TCPDO_BACKOFF when the loss or ECN response set ssthresh.
+ *
+ * TCPDO_PROBE is or-ed in when the window was first pushed up because no
+ * oscillation was measured, TCPDO_DEFERRED when per-RTT growth held the
+ * branch's change back until a window of data is acknowledged.  The segment
+ * counts are those of TcpDo; TcpDo v1 takes the same branches with its own
+ * constants.
+ */
+enum TcpDoDecision : uint8_t
+{
+    TCPDO_REDUCE_DELAY = 0,     //!< Vegas or RTT above the RTT threshold: mild reduction
+    TCPDO_REDUCE_FREQUENCY = 1, //!< Oscillation metric above the threshold: strong reduction
+    TCPDO_GROW_FAST = 2,        //!< diff below alpha: +7 segments
+    TCPDO_SHRINK = 3,           //!< diff above beta: -1 segment
+    TCPDO_GROW_MODERATE = 4,    //!< Otherwise: up to half a window, capped by ssthresh
+    TCPDO_BACKOFF = 5,          //!< ssthresh set by the loss (TcpDo v1) or ECN response
+    TCPDO_DEFERRED = 0x40,      //!< Flag: per-RTT growth, nothing applied on this ACK
+    TCPDO_PROBE = 0x80,         //!< Flag: +15 segments and a lower threshold first
+};
+
+/**
+ * \param decision a TcpDoDecision, with or without flags
+ * \return the lower-case name of the branch
+ */
+const char* GetTcpDoDecisionName(uint8_t decision);
+
+/**
+ * \brief Oscillation-based congestion detection and window policy of TcpDo.
+ *
+ * Holds all per-socket state of the algorithm and takes the current time
+ * as an argument instead of asking the simulator, so the exact same code
+ * runs inside TcpDo and in offline tools such as tcp-do-replay, where many
+ * detectors run concurrently on recorded RTT traces.
+ *
+ * The variants differ only in the policies bundled by \p Policies (see
+ * tcp-do-policies.h): the oscillation Metric, the RttRule giving the RTT
+ * threshold and the WindowRule.  The policies are plain members called
+ * directly, and this template is only instantiated in tcp-do-detector.cc
+ * next to their definitions, so the per-ACK path has no indirect calls.
+ *
+ * OnRtt() is the PktsAcked() part: it tracks the base RTT and feeds the
+ * metric, whose value is compared against the congestion threshold.  With
+ * spectral detection enabled the amplitude of the dominant RTT oscillation
+ * found by an RttSpectrum replaces the metric, evaluated once per time
+ * window; its frequency is reported by GetDominantFrequency().
+ * UpdateWindow() is the IncreaseWindow() part.
+ *
+ * The window rules take a growth step on every ACK, so growth scales with
+ * the ACK rate and delayed-ACK settings.  With per-RTT growth enabled the
+ * growth branches instead accumulate the acknowledged bytes as credit and
+ * only apply their step once a full cwnd of data has been acknowledged,
+ * i.e. about once per RTT, scaled by the growth scale and optionally capped.
+ * The threshold adaptation of those branches follows the same cadence.
+ * Updates that lower cwnd or set ssthresh still apply immediately and
+ * discard the accumulated credit.  Whether an update reduces is decided
+ * from its result, not its branch: a shrink step taken together with a
+ * probe raises cwnd in total and waits for the credit like any growth.
+ *
+ * \tparam Policies TcpDoPolicies or TcpDoV1Policies
+ */
+template <typename Policies>
+class TcpDoDetector
+{
+public:
+    typedef typename Policies::Metric Metric;         //!< Oscillation metric
+    typedef typename Policies::RttRule RttRule;       //!< RTT threshold rule
+    typedef typename Policies::WindowRule WindowRule; //!< Window policy
+
+    TcpDoDetector();
+
+    /**
+     * \brief Copy every per-connection state, with a spectrum of its own.
+     * \param other detector to copy
+     */
+    TcpDoDetector(const TcpDoDetector& other);
+
+    TcpDoDetector& operator=(const TcpDoDetector&) = delete;
+
+    /**
+     * \param threshold oscillation metric above which congestion is assumed
+     */
+    void SetCongestionThreshold(double threshold);
+
+    /**
+     * \return the current threshold, which adapts after every decision
+     */
+    double GetCongestionThreshold() const;
+
+    /**
+     * \param window interval between oscillation evaluations
+     */
+    void SetTimeWindow(Time window);
+
+    /**
+     * \return the interval between oscillation evaluations
+     */
+    Time GetTimeWindow() const;
+
+    /**
+     * \copydoc TcpDoMetricSettings::SetRttHistoryBounds
+     */
+    void SetRttHistoryBounds(size_t minSize, size_t maxSize);
+
+    /**
+     * \return the smallest adaptive RTT history size
+     */
+    size_t GetMinRttHistorySize() const;
+
+    /**
+     * \return the largest adaptive RTT history size
+     */
+    size_t GetMaxRttHistorySize() const;
+
+    /**
+     * \return the current adaptive RTT history size
+     */
+    size_t GetRttHistorySize() const;
+
+    /**
+     * \brief Choose the oscillation metric.
+     * \param enable true for the spectral amplitude, false for the policy metric
+     */
+    void SetSpectralDetection(bool enable);
+
+    /**
+     * \return true if the spectral amplitude is the oscillation metric
+     */
+    bool IsSpectralDetection() const;
+
+    /**
+     * \param period resampling period of the spectral detector
+     */
+    void SetSpectralSamplePeriod(Time period);
+
+    /**
+     * \return the resampling period of the spectral detector
+     */
+    Time GetSpectralSamplePeriod() const;
+
+    /**
+     * \param enable true to apply growth steps once per window of acknowledged data
+     */
+    void SetPerRttGrowth(bool enable);
+
+    /**
+     * \return true if growth steps are applied once per window of acknowledged data
+     */
+    bool IsPerRttGrowth() const;
+
+    /**
+     * \param scale factor applied to every per-RTT growth step
+     */
+    void SetGrowthScale(double scale);
+
+    /**
+     * \return the factor applied to every per-RTT growth step
+     */
+    double GetGrowthScale() const;
+
+    /**
+     * \param segments largest per-RTT growth step in segments, 0 for no limit
+     */
+    void SetMaxRttGrowth(uint32_t segments);
+
+    /**
+     * \return the largest per-RTT growth step in segments, 0 for no limit
+     */
+    uint32_t GetMaxRttGrowth() const;
+
+    /**
+     * \return the last evaluated oscillation metric, in seconds
+     */
+    double GetLastOscillationFrequency() const;
+
+    /**
+     * \return the frequency of the dominant RTT oscillation in Hz at the last
+     *         evaluation, 0 unless spectral detection is enabled
+     */
+    double GetDominantFrequency() const;
+
+    /**
+     * \return the smallest RTT seen, zero before the first sample
+     */
+    Time GetBaseRtt() const;
+
+    /**
+     * \return the RTT rule's reference RTT in seconds, used by the
+     *         loss response policies
+     */
+    double GetReferenceRtt() const;
+
+    /**
+     * \return the RTT rule's threshold in seconds, above which the last RTT
+     *         counts as a congestion signal
+     */
+    double GetRttThreshold() const;
+
+    /**
+     * \brief Account for an RTT sample.
+     * \param now time of the sample
+     * \param rtt the sample
+     */
+    void OnRtt(Time now, Time rtt);
+
+    /**
+     * \brief Adjust the window after an ACK.
+     * \param now time of the ACK
+     * \param lastRtt latest RTT sample of the socket
+     * \param segmentsAcked segments acknowledged by the ACK
+     * \param window window to adjust in place
+     * \param detail set to the signals and factors behind the decision
+     * \return the branch taken
+     */
+    uint8_t UpdateWindow(Time now,
+                         Time lastRtt,
+                         uint32_t segmentsAcked,
+                         TcpDoWindow& window,
+                         TcpDoDecisionDetail& detail);
+
+private:
+    double m_congestionThreshold; //!< Adaptive congestion threshold
+    Time m_baseRtt;               //!< Smallest RTT seen
+    Metric m_metric;              //!< Oscillation metric and adaptive RTT history
+    RttRule m_rttRule;            //!< RTT threshold
+    WindowRule m_windowRule;      //!< Window policy
+    bool m_spectralDetection;     //!< True if m_spectrum replaces m_metric
+    Ptr<RttSpectrum> m_spectrum;  //!< Sliding DFT of the resampled RTT, null while spectral detection is off
+    Time m_spectralSamplePeriod;  //!< Resampling period of m_spectrum
+    double m_spectralAmplitude;   //!< Dominant amplitude at the last evaluation
+    double m_dominantFrequency;   //!< Dominant frequency at the last evaluation, Hz
+    Time m_lastSpectrumTime;      //!< Time of the last spectral evaluation
+    bool m_perRttGrowth;          //!< True if growth steps wait for a window of ACKs
+    double m_growthScale;         //!< Factor applied to every per-RTT growth step
+    uint32_t m_maxRttGrowth;      //!< Largest per-RTT growth step in segments, 0 for none
+    uint64_t m_growthCredit;      //!< Bytes acknowledged since the last growth step
+};
+
+extern template class TcpDoDetector<TcpDoPolicies>;
+extern template class TcpDoDetector<TcpDoV1Policies>;
+
+} // namespace ns3
+
+#endif // TCP_DO_DETECTOR_H
@@ -0,0 +1,475 @@
+#ifndef TCP_DO_POLICIES_H
+#define TCP_DO_POLICIES_H
+
+#include "rtt-oscillation-estimator.h"
+#include "rtt-ring-buffer.h"
+#include "rtt-window-statistics.h"
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <limits>
+
+namespace ns3 {
+
+/**
+ * \brief Congestion window fields read and written by the TcpDo policies.
+ *
+ * Mirrors the TcpSocketState fields with the same unsigned arithmetic, so
+ * the detector behaves identically inside and outside a socket.
+ */
+struct TcpDoWindow
+{
+    uint32_t cWnd;        //!< Congestion window, bytes
+    uint32_t ssThresh;    //!< Slow start threshold, bytes
+    uint32_t segmentSize; //!< Segment size, bytes
+};
+
+/**
+ * \brief Congestion signals behind a window update, or-ed into
+ *        TcpDoDecisionDetail::causes.
+ */
+enum TcpDoCause : uint8_t
+{
+    TCPDO_CAUSE_VEGAS = 0x01,          //!< cwnd above ssthresh
+    TCPDO_CAUSE_FREQUENCY = 0x02,      //!< Oscillation metric above the congestion threshold
+    TCPDO_CAUSE_HIGH_RTT = 0x04,       //!< Last RTT above the RTT rule's threshold or reference
+    TCPDO_CAUSE_RETRANSMISSION = 0x08, //!< Loss signalled by a fast retransmit or RTO
+    TCPDO_CAUSE_ECN = 0x10,            //!< CE marks echoed by the receiver (ECE)
+};
+
+/**
+ * \brief Why and by how much a window update changed the window.
+ *
+ * Filled in by the window and loss response policies on every update, for
+ * the decision audit log; a handful of stores that cost nothing measurable
+ * when nobody reads them.
+ */
+struct TcpDoDecisionDetail
+{
+    uint8_t causes;             //!< TcpDoCause flags
+    double oscillation;         //!< Metric compared against the threshold, seconds
+    double congestionThreshold; //!< Threshold it was compared against (v1: after its per-ACK 1.01 step)
+    double severity;            //!< oscillation / congestionThreshold, 0 without a reduction
+    double reductionFactor;     //!< Factor applied to the reduced window, 1 without a reduction
+};
+
+/**
+ * \brief Time window and adaptive RTT history bounds shared by the
+ *        oscillation metrics.
+ */
+class TcpDoMetricSettings
+{
+public:
+    /**
+     * \param timeWindow interval between oscillation evaluations
+     * \param historySize initial adaptive RTT history size
+     */
+    TcpDoMetricSettings(Time timeWindow, size_t historySize);
+
+    /**
+     * \param window interval between oscillation evaluations
+     */
+    void SetTimeWindow(Time window);
+
+    /**
+     * \return the interval between oscillation evaluations
+     */
+    Time GetTimeWindow() const;
+
+    /**
+     * \brief Bound the adaptive RTT history size.
+     *
+     * The current size is clamped into the new bounds.
+     *
+     * \param minSize smallest history, at least 1
+     * \param maxSize largest history, below the RttHistory capacity
+     */
+    void SetRttHistoryBounds(size_t minSize, size_t maxSize);
+
+    /**
+     * \return the smallest adaptive RTT history size
+     */
+    size_t GetMinRttHistorySize() const;
+
+    /**
+     * \return the largest adaptive RTT history size
+     */
+    size_t GetMaxRttHistorySize() const;
+
+    /**
+     * \return the current adaptive RTT history size
+     */
+    size_t GetRttHistorySize() const;
+
+protected:
+    /**
+     * \brief Grow the history while congested, shrink it otherwise.
+     * \param congested true if the metric is above the congestion threshold
+     */
+    void AdaptRttHistorySize(bool congested);
+
+    Time m_timeWindow;           //!< Interval between oscillation evaluations
+    size_t m_rttHistorySize;     //!< Current adaptive RTT history size
+    size_t m_minRttHistorySize;  //!< Lower bound of m_rttHistorySize
+    size_t m_maxRttHistorySize;  //!< Upper bound of m_rttHistorySize
+};
+
+/**
+ * \brief Oscillation metric of TcpDo: weighted RTT deviation, evaluated once
+ *        per time window.
+ *
+ * The newest sample is compared against the adaptive RTT history before it
+ * joins it (RttOscillationEstimator), and the history grows while the
+ * metric is above the congestion threshold.
+ */
+class TcpDoWindowedDeviation : public TcpDoMetricSettings
+{
+public:
+    TcpDoWindowedDeviation();
+
+    /**
+     * \brief Account for an RTT sample.
+     * \param now time of the sample
+     * \param rtt the sample
+     * \param congestionThreshold current congestion threshold
+     */
+    void OnRtt(Time now, Time rtt, double congestionThreshold);
+
+    /**
+     * \return the last evaluated metric, in seconds
+     */
+    double GetOscillation() const
+    {
+        return m_oscillation;
+    }
+
+private:
+    RttOscillationEstimator m_rttHistory; //!< Adaptive RTT history with running sums
+    double m_oscillation;                 //!< Last evaluated metric
+    uint32_t m_oscillationCount;          //!< RTT changes counted in the current window
+    Time m_lastCalculationTime;           //!< Time of the last evaluation
+    Time m_prevRtt;                       //!< Previous RTT sample
+};
+
+/**
+ * \brief Oscillation metric of TcpDo v1: weighted RTT deviation on every ACK.
+ *
+ * The newest sample joins the adaptive RTT history first and is then
+ * compared against its weighted mean (weight 1.0 for the newest sample,
+ * +0.2 per older one).  The RTT changes counted per time window only steer
+ * the history size.
+ */
+class TcpDoPerAckDeviation : public TcpDoMetricSettings
+{
+public:
+    TcpDoPerAckDeviation();
+
+    /**
+     * \copydoc TcpDoWindowedDeviation::OnRtt
+     */
+    void OnRtt(Time now, Time rtt, double congestionThreshold);
+
+    /**
+     * \return the metric of the last sample, in seconds
+     */
+    double GetOscillation() const
+    {
+        return m_oscillation;
+    }
+
+private:
+    RttHistory m_rttHistory;     //!< Adaptive RTT history, oldest first
+    double m_oscillation;        //!< Metric of the last sample
+    uint32_t m_oscillationCount; //!< RTT changes counted in the current window
+    Time m_windowStartTime;      //!< Start of the current counting window
+    Time m_prevRtt;              //!< Previous RTT sample
+};
+
+/**
+ * \brief RTT threshold of TcpDo: 1.2 times the base RTT.
+ */
+class TcpDoBaseRttRule
+{
+public:
+    /**
+     * \brief Account for an RTT sample; the base RTT needs no extra state.
+     */
+    void OnRtt(Time /* rtt */, size_t /* windowSize */)
+    {
+    }
+
+    /**
+     * \param baseRtt smallest RTT seen
+     * \return the RTT in seconds above which congestion is assumed
+     */
+    double GetThreshold(Time baseRtt) const
+    {
+        return baseRtt.GetSeconds() * 1.2;
+    }
+
+    /**
+     * \param baseRtt smallest RTT seen
+     * \return the RTT in seconds that retransmission handling compares against
+     */
+    double GetReference(Time baseRtt) const
+    {
+        return baseRtt.GetSeconds();
+    }
+};
+
+/**
+ * \brief RTT threshold of TcpDo v1: mean plus 1.5 standard deviations of the
+ *        last RTT samples.
+ *
+ * The window follows the metric's adaptive history size.  The threshold is
+ * infinite, so it never fires, until the first sample arrives.
+ */
+class TcpDoRttSpreadRule
+{
+public:
+    /**
+     * \brief Account for an RTT sample.
+     * \param rtt the sample
+     * \param windowSize samples to keep, the metric's current history size
+     */
+    void OnRtt(Time rtt, size_t windowSize);
+
+    /**
+     * \copydoc TcpDoBaseRttRule::GetThreshold
+     */
+    double GetThreshold(Time /* baseRtt */) const
+    {
+        if (m_stats.GetCount() == 0)
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+        return m_stats.GetMean() + 1.5 * m_stats.GetStdDev();
+    }
+
+    /**
+     * \copydoc TcpDoBaseRttRule::GetReference
+     */
+    double GetReference(Time /* baseRtt */) const
+    {
+        return m_stats.GetCount() > 0 ? m_stats.GetMean() : std::numeric_limits<double>::infinity();
+    }
+
+private:
+    RttHistory m_window;          //!< Last samples, oldest first
+    RttWindowStatistics m_stats;  //!< Mean and variance of m_window
+};
+
+/**
+ * \brief Window policy of TcpDo.
+ *
+ * The oscillation metric is sampled once per time window.  Delay-based
+ * detections reduce the window mildly, metric-based ones more strongly;
+ * without congestion the window grows by 7 segments, shrinks by one or
+ * grows moderately depending on how far cwnd is above ssthresh.
+ */
+class TcpDoWindowRule
+{
+public:
+    TcpDoWindowRule();
+
+    /**
+     * \brief Adjust the window after an ACK.
+     * \param now time of the ACK
+     * \param timeWindow interval between oscillation evaluations
+     * \param oscillation current oscillation metric
+     * \param rttAboveThreshold true if the last RTT is above the RTT rule's threshold
+     * \param congestionThreshold threshold to compare against and adapt in place
+     * \param window window to adjust in place
+     * \param detail set to the signals and factors behind the decision
+     * \return the TcpDoDecision taken
+     */
+    uint8_t Update(Time now,
+                   Time timeWindow,
+                   double oscillation,
+                   bool rttAboveThreshold,
+                   double& congestionThreshold,
+                   TcpDoWindow& window,
+                   TcpDoDecisionDetail& detail);
+
+private:
+    double m_cachedOscillation; //!< Metric sampled at the last window boundary
+    Time m_lastIncreaseTime;    //!< Time m_cachedOscillation was sampled
+};
+
+/**
+ * \brief Window policy of TcpDo v1.
+ *
+ * Reads the metric on every ACK and raises the threshold by 1% per ACK.
+ * Every detection reduces the window the same way; without congestion the
+ * window grows by 6 segments, shrinks by 3 or grows moderately.
+ */
+class TcpDoV1WindowRule
+{
+public:
+    /**
+     * \copydoc TcpDoWindowRule::Update
+     */
+    uint8_t Update(Time now,
+                   Time timeWindow,
+                   double oscillation,
+                   bool rttAboveThreshold,
+                   double& congestionThreshold,
+                   TcpDoWindow& window,
+                   TcpDoDecisionDetail& detail);
+};
+
+/**
+ * \brief Loss response of TcpDo: the slow start threshold of TcpVegas.
+ */
+class TcpDoVegasLossResponse
+{
+public:
+    /**
+     * \brief Choose the slow start threshold after a fast retransmit or RTO.
+     * \param currentRtt last RTT sample in seconds
+     * \param referenceRtt RTT rule reference in seconds
+     * \param window window at the time of the loss
+     * \param ssThresh set to the new slow start threshold if true is returned
+     * \param detail set to the causes and reduction factor if true is returned;
+     *        oscillation and threshold are left to the caller
+     * \return false to fall back to TcpVegas::GetSsThresh()
+     */
+    bool GetSsThresh(double /* currentRtt */,
+                     double /* referenceRtt */,
+                     const TcpDoWindow& /* window */,
+                     uint32_t& /* ssThresh */,
+                     TcpDoDecisionDetail& /* detail */)
+    {
+        return false;
+    }
+};
+
+/**
+ * \brief Loss response of TcpDo v1: tell congestion from random loss by RTT.
+ *
+ * A loss with the last RTT above the RTT rule's reference counts as
+ * congestion and drops ssthresh to two thirds of cwnd.  Otherwise the loss
+ * is taken as random, e.g. a lossy link, and ssthresh only drops to cwnd /
+ * 1.1, so random loss costs little window.  ssthresh never goes below two
+ * segments.
+ */
+class TcpDoRttLossResponse
+{
+public:
+    /**
+     * \copydoc TcpDoVegasLossResponse::GetSsThresh
+     */
+    bool GetSsThresh(double currentRtt,
+                     double referenceRtt,
+                     const TcpDoWindow& window,
+                     uint32_t& ssThresh,
+                     TcpDoDecisionDetail& detail);
+};
+
+/**
+ * \brief How TcpDo reacts to ECN congestion experienced marks.
+ */
+enum TcpDoEcnMode : uint8_t
+{
+    TCPDO_ECN_OFF = 0,     //!< No ECN negotiation, CE marks are not a signal
+    TCPDO_ECN_CLASSIC = 1, //!< Halve the window once per RTT with marks (RFC 3168)
+    TCPDO_ECN_DCTCP = 2,   //!< Reduce by half the smoothed fraction of marked bytes
+};
+
+/**
+ * \brief ECN response of both TcpDo variants, selected at run time.
+ *
+ * The socket asks for a new slow start threshold on the first ACK with ECE
+ * and then stays in CWR until the window sent at that point is
+ * acknowledged, so either mode reduces at most once per RTT.  The classic
+ * mode halves cwnd like a loss would.  The DCTCP mode keeps
+ * alpha = (1 - g) * alpha + g * F, with F the fraction of bytes acknowledged
+ * with ECE over the last window of data, and reduces cwnd by alpha / 2, so a
+ * few marks cost little window and persistent marking halves it.  ssthresh
+ * never goes below two segments.
+ */
+class TcpDoEcnResponse
+{
+public:
+    TcpDoEcnResponse();
+
+    /**
+     * \param mode ECN reaction
+     */
+    void SetMode(TcpDoEcnMode mode);
+
+    /**
+     * \return the ECN reaction
+     */
+    TcpDoEcnMode GetMode() const;
+
+    /**
+     * \param gain weight g of a new window's marked fraction, in (0, 1]
+     */
+    void SetGain(double gain);
+
+    /**
+     * \return the weight g of a new window's marked fraction
+     */
+    double GetGain() const;
+
+    /**
+     * \return the smoothed fraction of marked bytes
+     */
+    double GetAlpha() const;
+
+    /**
+     * \brief Count acknowledged bytes towards the current observation window.
+     * \param bytesAcked bytes newly acknowledged
+     * \param marked true if the ACK carried ECE
+     */
+    void OnAck(uint32_t bytesAcked, bool marked);
+
+    /**
+     * \brief Fold the marked fraction of the finished window into alpha.
+     */
+    void EndWindow();
+
+    /**
+     * \brief Choose the slow start threshold after an ACK with ECE.
+     * \param window window at the time of the mark
+     * \param ssThresh set to the new slow start threshold
+     * \param detail set to the causes and reduction factor; oscillation and
+     *        threshold are left to the caller
+     */
+    void GetSsThresh(const TcpDoWindow& window, uint32_t& ssThresh, TcpDoDecisionDetail& detail) const;
+
+private:
+    TcpDoEcnMode m_mode;    //!< ECN reaction
+    double m_gain;          //!< Weight g of a new window's marked fraction
+    double m_alpha;         //!< Smoothed fraction of marked bytes
+    uint64_t m_ackedBytes;  //!< Bytes acknowledged in the current window
+    uint64_t m_markedBytes; //!< Bytes acknowledged with ECE in the current window
+};
+
+/**
+ * \brief Policies of the original TcpDo (ns3::TcpDo).
+ */
+struct TcpDoPolicies
+{
+    typedef TcpDoWindowedDeviation Metric;
+    typedef TcpDoBaseRttRule RttRule;
+    typedef TcpDoWindowRule WindowRule;
+    typedef TcpDoVegasLossResponse LossResponse;
+};
+
+/**
+ * \brief Policies of TcpDo v1 (ns3::TcpDoV1).
+ */
+struct TcpDoV1Policies
+{
+    typedef TcpDoPerAckDeviation Metric;
+    typedef TcpDoRttSpreadRule RttRule;
+    typedef TcpDoV1WindowRule WindowRule;
+    typedef TcpDoRttLossResponse LossResponse;
+};
+
+} // namespace ns3
+
+#endif // TCP_DO_POLICIES_H
@@ -0,0 +1,276 @@
+#include "parse-list.h"
+#include "rtt-trace-reader.h"
+#include "tcp-do-detector.h"
+
+#include "ns3/core-module.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+// Offline replay of recorded RTT traces through the TcpDo detector.
+//
+// Every RTT sample of the trace is treated as one ACK: it is passed to
+// TcpDoDetector::OnRtt() and TcpDoDetector::UpdateWindow() at its recorded
+// time, exactly as TcpDo does inside a socket, with a synthetic window.
+// Every combination of the parameter lists is replayed independently, spread
+// over all cores, and summarized as one CSV line:
+//
+//   tcp-do-replay --input=trace-tcpdo-dumbbell.bin --flow=0 --variants=TcpDo,TcpDoV1
+//       --thresholds=0.0005,0.001,0.002 --timeWindows=5ms,10ms,20ms
+//       --minHistory=5,10 --maxHistory=30,50 --output=replay.csv
+//
+// --flow picks one flow of a multi-flow trace, flow 0 by default; the
+// two-column CSV files hold a single flow and ignore it.
+//
+// --variants picks the policy sets of tcp-do-policies.h; note that the
+// default --timeWindows is TcpDo's, TcpDoV1 uses 100ms in a socket.
+// --modes=deviation,spectral replays both oscillation metrics; the spectral
+// one is swept over --samplePeriods, the history bounds only apply to the
+// deviation metric.
+//
+// --events writes every decision of one combination (--eventCombination,
+// in the order of the summary) for a closer look:
+//
+//   tcp-do-replay --input=rtt-tcpdo-wired.csv --events=events.csv
+//
+// The window only follows TcpDo's own decisions; losses, recovery and
+// application limits of the recorded run are not modelled.
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpDoReplay");
+
+/**
+ * One point of the parameter grid.
+ */
+struct ReplayParameters
+{
+    bool v1;             //!< TcpDoV1 policies instead of TcpDo
+    double threshold;    //!< Initial CongestionThreshold
+    Time timeWindow;     //!< TimeWindow
+    uint32_t minHistory; //!< MinRttHistorySize
+    uint32_t maxHistory; //!< MaxRttHistorySize
+    bool spectral;       //!< SpectralDetection
+    Time samplePeriod;   //!< SpectralSamplePeriod, spectral mode only
+};
+
+/**
+ * Outcome of replaying one trace with one parameter set.
+ */
+struct ReplayResult
+{
+    uint64_t decisions[TCPDO_GROW_MODERATE + 1]; //!< ACKs per window branch
+    uint64_t probes;                             //!< ACKs with TCPDO_PROBE set
+    Time firstDetection;                         //!< First reduction, negative if none
+    double meanCwnd;                             //!< Mean window after each ACK, segments
+    double finalCwnd;                            //!< Window after the last ACK, segments
+    double finalThreshold;                       //!< Adapted threshold at the end
+};
+
+// 하나의 파라미터 조합으로 전체 트레이스를 재생
+template <typename Policies>
+ReplayResult Replay(const std::vector<RttSample>& samples,
+                    const ReplayParameters& parameters,
+                    const TcpDoWindow& initialWindow,
+                    std::ostream* events)
+{
+    TcpDoDetector<Policies> detector;
+    detector.SetCongestionThreshold(parameters.threshold);
+    detector.SetTimeWindow(parameters.timeWindow);
+    detector.SetRttHistoryBounds(parameters.minHistory, parameters.maxHistory);
+    detector.SetSpectralDetection(parameters.spectral);
+    if (parameters.spectral)
+    {
+        detector.SetSpectralSamplePeriod(parameters.samplePeriod);
+    }
+
+    ReplayResult result = {};
+    result.firstDetection = Seconds(-1);
+    TcpDoWindow window = initialWindow;
+    TcpDoDecisionDetail detail;
+    double cwndSum = 0.0;
+
+    for (const RttSample& sample : samples)
+    {
+        detector.OnRtt(sample.time, sample.rtt);
+        uint8_t decision = detector.UpdateWindow(sample.time, sample.rtt, 1, window, detail);
+
+        uint8_t branch = decision & ~(TCPDO_PROBE | TCPDO_DEFERRED);
+        ++result.decisions[branch];
+        result.probes += (decision & TCPDO_PROBE) ? 1 : 0;
+        if (branch <= TCPDO_REDUCE_FREQUENCY && result.firstDetection.IsNegative())
+        {
+            result.firstDetection = sample.time;
+        }
+        cwndSum += window.cWnd;
+
+        if (events)
+        {
+            *events << sample.time.GetSeconds() << "," << sample.rtt.GetSeconds() * 1e3 << ","
+                    << detector.GetLastOscillationFrequency() << "," << detector.GetDominantFrequency() << ","
+                    << detector.GetCongestionThreshold() << ","
+                    << detector.GetRttHistorySize() << "," << GetTcpDoDecisionName(decision) << ","
+                    << ((decision & TCPDO_PROBE) ? 1 : 0) << "," << window.cWnd << "," << window.ssThresh
+                    << "\n";
+        }
+    }
+
+    result.meanCwnd = samples.empty() ? 0.0 : cwndSum / samples.size() / window.segmentSize;
+    result.finalCwnd = static_cast<double>(window.cWnd) / window.segmentSize;
+    result.finalThreshold = detector.GetCongestionThreshold();
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string input;
+    int64_t flow = 0;
+    std::string variants = "TcpDo";
+    std::string thresholds = "0.001";
+    std::string timeWindows = "10ms";
+    std::string minHistory = "10";
+    std::string maxHistory = "50";
+    std::string modes = "deviation";
+    std::string samplePeriods = "1ms";
+    uint32_t segmentSize = 1448;
+    uint32_t initialCwnd = 10;
+    uint32_t threads = std::max(1U, std::thread::hardware_concurrency());
+    std::string output = "replay.csv";
+    std::string events;
+    uint32_t eventCombination = 0;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("input", "Recorded RTT trace (binary trace or CSV)", input);
+    cmd.AddValue("flow", "Flow id to take from the trace, negative mixes every flow into one detector", flow);
+    cmd.AddValue("variants", "Comma separated variants: TcpDo, TcpDoV1", variants);
+    cmd.AddValue("thresholds", "Comma separated CongestionThreshold values", thresholds);
+    cmd.AddValue("timeWindows", "Comma separated TimeWindow values, e.g. 5ms,10ms", timeWindows);
+    cmd.AddValue("minHistory", "Comma separated MinRttHistorySize values", minHistory);
+    cmd.AddValue("maxHistory", "Comma separated MaxRttHistorySize values", maxHistory);
+    cmd.AddValue("modes", "Comma separated oscillation metrics: deviation, spectral", modes);
+    cmd.AddValue("samplePeriods", "Comma separated SpectralSamplePeriod values", samplePeriods);
+    cmd.AddValue("segmentSize", "Segment size of the synthetic window", segmentSize);
+    cmd.AddValue("initialCwnd", "Initial window in segments", initialCwnd);
+    cmd.AddValue("threads", "Worker threads", threads);
+    cmd.AddValue("output", "Summary CSV, one line per combination", output);
+    cmd.AddValue("events", "Write every decision of one combination to this CSV", events);
+    cmd.AddValue("eventCombination", "Combination written to --events, in summary order", eventCombination);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(input.empty(), "--input is required");
+
+    // 스레드를 시작하기 전에 시뮬레이터를 초기화하여 Time 마킹을 종료
+    Simulator::Now();
+
+    std::vector<RttSample> samples = ReadRttTrace(input, flow);
+    NS_ABORT_MSG_IF(samples.empty(), input << " holds no RTT samples");
+
+    std::vector<ReplayParameters> points;
+    for (const std::string& mode : ParseList<std::string>(modes))
+    {
+        NS_ABORT_MSG_UNLESS(mode == "deviation" || mode == "spectral", "Unknown mode \"" << mode << "\"");
+        bool spectral = (mode == "spectral");
+        // 편차 모드에는 재표본화 주기가 없으므로 한 번만 생성
+        std::vector<Time> periods = spectral ? ParseList<Time>(samplePeriods) : std::vector<Time>{Time(0)};
+        for (Time period : periods)
+        {
+            NS_ABORT_MSG_IF(spectral && !period.IsStrictlyPositive(), "Sample periods must be positive");
+            for (double threshold : ParseList<double>(thresholds))
+            {
+                for (Time timeWindow : ParseList<Time>(timeWindows))
+                {
+                    for (uint32_t minSize : ParseList<uint32_t>(minHistory))
+                    {
+                        for (uint32_t maxSize : ParseList<uint32_t>(maxHistory))
+                        {
+                            if (minSize <= maxSize)
+                            {
+                                points.push_back(ReplayParameters{false, threshold, timeWindow, minSize, maxSize,
+                                                                  spectral, period});
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // 변형마다 같은 파라미터 격자를 반복
+    std::vector<ReplayParameters> grid;
+    for (const std::string& variant : ParseList<std::string>(variants))
+    {
+        NS_ABORT_MSG_UNLESS(variant == "TcpDo" || variant == "TcpDoV1", "Unknown variant \"" << variant << "\"");
+        for (ReplayParameters point : points)
+        {
+            point.v1 = (variant == "TcpDoV1");
+            grid.push_back(point);
+        }
+    }
+    NS_ABORT_MSG_IF(grid.empty(), "No combination with minHistory <= maxHistory");
+    NS_ABORT_MSG_IF(!events.empty() && eventCombination >= grid.size(),
+                    "--eventCombination must be below " << grid.size());
+
+    // 원래 소켓의 기본값과 같이 ssthresh는 최댓값에서 시작
+    TcpDoWindow initialWindow = {initialCwnd * segmentSize, 0xffffffff, segmentSize};
+
+    std::ofstream eventFile;
+    if (!events.empty())
+    {
+        eventFile.open(events, std::ios::out | std::ios::trunc);
+        NS_ABORT_MSG_UNLESS(eventFile.is_open(), "Cannot open " << events);
+        eventFile << "time,rtt_ms,frequency,dominant_hz,threshold,history,decision,probe,cwnd,ssthresh\n";
+    }
+
+    // 조합 단위로 작업을 나누어 모든 코어에서 재생
+    std::vector<ReplayResult> results(grid.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        size_t i;
+        while ((i = next.fetch_add(1)) < grid.size())
+        {
+            std::ostream* out = (eventFile.is_open() && i == eventCombination) ? &eventFile : nullptr;
+            results[i] = grid[i].v1 ? Replay<TcpDoV1Policies>(samples, grid[i], initialWindow, out)
+                                    : Replay<TcpDoPolicies>(samples, grid[i], initialWindow, out);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (uint32_t t = 1; t < std::min<size_t>(threads, grid.size()); ++t)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : pool)
+    {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ofstream file(output, std::ios::out | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(file.is_open(), "Cannot open " << output);
+    file << "variant,mode,sample_period_ms,threshold,time_window_ms,min_history,max_history,acks,reduce_delay,"
+            "reduce_frequency,grow_fast,shrink,grow_moderate,probes,first_detection_s,mean_cwnd_segments,"
+            "final_cwnd_segments,final_threshold\n";
+    for (size_t i = 0; i < grid.size(); ++i)
+    {
+        const ReplayParameters& p = grid[i];
+        const ReplayResult& r = results[i];
+        file << (p.v1 ? "TcpDoV1" : "TcpDo") << "," << (p.spectral ? "spectral" : "deviation") << ","
+             << p.samplePeriod.GetSeconds() * 1e3 << "," << p.threshold << "," << p.timeWindow.GetSeconds() * 1e3
+             << "," << p.minHistory << "," << p.maxHistory << "," << samples.size();
+        for (uint64_t count : r.decisions)
+        {
+            file << "," << count;
+        }
+        file << "," << r.probes << "," << r.firstDetection.GetSeconds() << "," << r.meanCwnd << ","
+             << r.finalCwnd << "," << r.finalThreshold << "\n";
+    }
+
+    std::cerr << grid.size() << " combination(s) x " << samples.size() << " samples in " << elapsed << " s ("
+              << grid.size() * samples.size() / elapsed / 1e6 << " M samples/s)" << std::endl;
+    return 0;
+}
@@ -1,215 +1,502 @@
 #include "tcp-do.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
 #include <algorithm> // std::max 사용
+#include <limits>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE("TcpDo");
 
 NS_OBJECT_ENSURE_REGISTERED(TcpDo);
+NS_OBJECT_ENSURE_REGISTERED(TcpDoV1);
 
-TypeId TcpDo::GetTypeId(void)
+template <typename Policies>
+TypeId TcpDoBase<Policies>::AddAttributes(TypeId tid, Time timeWindow)
 {
-    static TypeId tid = TypeId("ns3::TcpDo")
-        .SetParent<TcpVegas>()
-        .SetGroupName("Internet")
-        .AddConstructor<TcpDo>()
+    return tid
         .AddAttribute("CongestionThreshold", "The threshold for oscillation frequency to detect congestion",
                       DoubleValue(0.001), // 기본 임계값 설정
-                      MakeDoubleAccessor(&TcpDo::m_congestionThreshold),
-                      MakeDoubleChecker<double>());
-    return tid;
+                      MakeDoubleAccessor(&TcpDoBase::SetCongestionThreshold, &TcpDoBase::GetCongestionThreshold),
+                      MakeDoubleChecker<double>())
+        .AddAttribute("TimeWindow", "Interval between oscillation frequency evaluations",
+                      TimeValue(timeWindow),
+                      MakeTimeAccessor(&TcpDoBase::SetTimeWindow, &TcpDoBase::GetTimeWindow),
+                      MakeTimeChecker())
+        .AddAttribute("MinRttHistorySize", "Lower bound of the adaptive RTT history size",
+                      UintegerValue(10),
+                      MakeUintegerAccessor(&TcpDoBase::SetMinRttHistorySize, &TcpDoBase::GetMinRttHistorySize),
+                      MakeUintegerChecker<uint32_t>(1, RttHistory::Capacity() - 1))
+        .AddAttribute("MaxRttHistorySize", "Upper bound of the adaptive RTT history size",
+                      UintegerValue(50),
+                      MakeUintegerAccessor(&TcpDoBase::SetMaxRttHistorySize, &TcpDoBase::GetMaxRttHistorySize),
+                      MakeUintegerChecker<uint32_t>(1, RttHistory::Capacity() - 1))
+        .AddAttribute("SpectralDetection",
+                      "Use the amplitude of the dominant RTT oscillation instead of the RTT deviation",
+                      BooleanValue(false),
+                      MakeBooleanAccessor(&TcpDoBase::SetSpectralDetection, &TcpDoBase::IsSpectralDetection),
+                      MakeBooleanChecker())
+        .AddAttribute("SpectralSamplePeriod", "Resampling period of the RTT signal for spectral detection",
+                      TimeValue(MilliSeconds(1)),
+                      MakeTimeAccessor(&TcpDoBase::SetSpectralSamplePeriod, &TcpDoBase::GetSpectralSamplePeriod),
+                      MakeTimeChecker(TimeStep(1)))
+        .AddAttribute("PerRttGrowth",
+                      "Apply growth steps once per cwnd of acknowledged data instead of on every ACK",
+                      BooleanValue(false),
+                      MakeBooleanAccessor(&TcpDoBase::SetPerRttGrowth, &TcpDoBase::IsPerRttGrowth),
+                      MakeBooleanChecker())
+        .AddAttribute("GrowthScale", "Factor applied to every per-RTT growth step",
+                      DoubleValue(1.0),
+                      MakeDoubleAccessor(&TcpDoBase::SetGrowthScale, &TcpDoBase::GetGrowthScale),
+                      MakeDoubleChecker<double>(0.0))
+        .AddAttribute("MaxRttGrowth", "Largest per-RTT growth step in segments, 0 for no limit",
+                      UintegerValue(0),
+                      MakeUintegerAccessor(&TcpDoBase::SetMaxRttGrowth, &TcpDoBase::GetMaxRttGrowth),
+                      MakeUintegerChecker<uint32_t>())
+        .AddAttribute("EcnMode",
+                      "Reaction to CE marks: Off, Classic (halve once per RTT) or Dctcp (scale by marked fraction)",
+                      EnumValue(TCPDO_ECN_OFF),
+                      MakeEnumAccessor(&TcpDoBase::SetEcnMode, &TcpDoBase::GetEcnMode),
+                      MakeEnumChecker(TCPDO_ECN_OFF, "Off", TCPDO_ECN_CLASSIC, "Classic", TCPDO_ECN_DCTCP, "Dctcp"))
+        .AddAttribute("EcnGain", "Weight of a new window's marked fraction in the Dctcp mode",
+                      DoubleValue(1.0 / 16),
+                      MakeDoubleAccessor(&TcpDoBase::SetEcnGain, &TcpDoBase::GetEcnGain),
+                      MakeDoubleChecker<double>(std::numeric_limits<double>::min(), 1.0))
+        .AddTraceSource("OscillationFrequency", "Oscillation metric compared against the threshold",
+                        MakeTraceSourceAccessor(&TcpDoBase::m_oscillationFrequency),
+                        "ns3::TracedValueCallback::Double")
+        .AddTraceSource("AdaptiveThreshold", "Congestion threshold as adapted by the window updates",
+                        MakeTraceSourceAccessor(&TcpDoBase::m_congestionThreshold),
+                        "ns3::TracedValueCallback::Double")
+        .AddTraceSource("RttHistorySize", "Current adaptive RTT history size",
+                        MakeTraceSourceAccessor(&TcpDoBase::m_rttHistorySize),
+                        "ns3::TracedValueCallback::Uint32")
+        .AddTraceSource("BaseRtt", "Smallest RTT seen",
+                        MakeTraceSourceAccessor(&TcpDoBase::m_baseRtt),
+                        "ns3::TracedValueCallback::Time")
+        .AddTraceSource("WindowDecision", "Branch taken by every window update (TcpDoDecision)",
+                        MakeTraceSourceAccessor(&TcpDoBase::m_windowDecision),
+                        "ns3::TcpDoBase::WindowDecisionTracedCallback")
+        .AddTraceSource("Audit", "Branch, congestion signals and window change of every window update",
+                        MakeTraceSourceAccessor(&TcpDoBase::m_audit),
+                        "ns3::TcpDoBase::AuditTracedCallback");
 }
 
-TcpDo::TcpDo()
-    : m_congestionThreshold(0.001),  // 초기화
-      m_lastOscillationFrequency(0.0), // 초기화
-      m_maxRttHistorySize(20), // 초기화
-      m_timeWindow(Seconds(0.01)), // 초기화
-      m_baseRtt(Time(0.0)),
-      m_lastCalculationTime(Time(0.0)) // 최소 RTT 및 마지막 계산 시간 초기화
+template <typename Policies>
+TcpDoBase<Policies>::TcpDoBase()
+    : m_inRecovery(false),
+      m_ecnNextSeq(0),
+      m_pendingLossSsThresh(0),
+      m_pendingLossDetail()
 {
+    UpdateTracedValues();
 }
 
-TcpDo::TcpDo(const TcpDo& sock)
+template <typename Policies>
+TcpDoBase<Policies>::TcpDoBase(const TcpDoBase& sock)
     : TcpVegas(sock),
-      m_congestionThreshold(sock.m_congestionThreshold),
-      m_lastOscillationFrequency(sock.m_lastOscillationFrequency),
-      m_oscillationCount(sock.m_oscillationCount),
-      m_timeWindow(sock.m_timeWindow),
-      m_baseRtt(sock.m_baseRtt),
-      m_lastCalculationTime(sock.m_lastCalculationTime) // 복사 생성자에서 최소 RTT와 마지막 계산 시간 초기화
+      m_detector(sock.m_detector), // 복사 생성자에서 모든 소켓별 상태 복사
+      m_lossResponse(sock.m_lossResponse),
+      m_inRecovery(sock.m_inRecovery),
+      m_ecnResponse(sock.m_ecnResponse),
+      m_ecnNextSeq(sock.m_ecnNextSeq),
+      m_pendingLossSsThresh(sock.m_pendingLossSsThresh),
+      m_pendingLossDetail(sock.m_pendingLossDetail)
 {
+    UpdateTracedValues();
 }
 
-TcpDo::~TcpDo() {}
+// 연결된 싱크가 없으면 값 비교만 수행
+template <typename Policies>
+void TcpDoBase<Policies>::UpdateTracedValues()
+{
+    m_oscillationFrequency = m_detector.GetLastOscillationFrequency();
+    m_congestionThreshold = m_detector.GetCongestionThreshold();
+    m_rttHistorySize = static_cast<uint32_t>(m_detector.GetRttHistorySize());
+    m_baseRtt = m_detector.GetBaseRtt();
+}
 
-std::string TcpDo::GetName() const
+template <typename Policies>
+void TcpDoBase<Policies>::SetCongestionThreshold(double threshold)
 {
-    return "TcpDo";
+    m_detector.SetCongestionThreshold(threshold);
+    m_congestionThreshold = threshold;
 }
 
-void TcpDo::PktsAcked(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time& rtt)
+template <typename Policies>
+double TcpDoBase<Policies>::GetCongestionThreshold() const
 {
-    TcpVegas::PktsAcked(tcb, segmentsAcked, rtt);
+    return m_detector.GetCongestionThreshold();
+}
 
-    // 최소 RTT 갱신
-    if (m_baseRtt == Time(0.0) || rtt < m_baseRtt)
-    {
-        m_baseRtt = rtt;
-    }
+template <typename Policies>
+void TcpDoBase<Policies>::SetTimeWindow(Time window)
+{
+    m_detector.SetTimeWindow(window);
+}
 
-    CalculateOscillationFrequency(rtt);
+template <typename Policies>
+Time TcpDoBase<Policies>::GetTimeWindow() const
+{
+    return m_detector.GetTimeWindow();
 }
 
-void TcpDo::IncreaseWindow(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked)
+// 속성 설정 순서와 상관없이 하한 <= 상한을 유지
+template <typename Policies>
+void TcpDoBase<Policies>::SetMinRttHistorySize(uint32_t size)
 {
-    static double lastOscillationFrequency = m_lastOscillationFrequency; // 마지막 계산된 진동수를 캐시
+    m_detector.SetRttHistoryBounds(size, std::max<size_t>(size, m_detector.GetMaxRttHistorySize()));
+}
 
-    // 별도의 타이머를 사용하여 비교
-    static Time lastIncreaseTime = Time(0);
+template <typename Policies>
+uint32_t TcpDoBase<Policies>::GetMinRttHistorySize() const
+{
+    return m_detector.GetMinRttHistorySize();
+}
 
-    // 진동수 계산 주기가 지나면 값을 갱신
-    Time now = Simulator::Now();
-    if (now - lastIncreaseTime >= m_timeWindow)
-    {
-        lastOscillationFrequency = m_lastOscillationFrequency;
-        lastIncreaseTime = now; // 마지막 계산 시간 갱신
+template <typename Policies>
+void TcpDoBase<Policies>::SetMaxRttHistorySize(uint32_t size)
+{
+    m_detector.SetRttHistoryBounds(std::min<size_t>(size, m_detector.GetMinRttHistorySize()), size);
+}
 
-        // NS_LOG_UNCOND("Oscillation Frequency updated in IncreaseWindow: " << lastOscillationFrequency);
-    }
+template <typename Policies>
+uint32_t TcpDoBase<Policies>::GetMaxRttHistorySize() const
+{
+    return m_detector.GetMaxRttHistorySize();
+}
 
+template <typename Policies>
+void TcpDoBase<Policies>::SetSpectralDetection(bool enable)
+{
+    m_detector.SetSpectralDetection(enable);
+}
 
-    bool vegasDetectedCongestion = (tcb->m_cWnd.Get() > tcb->m_ssThresh);
-    double currentOscillationFrequency = lastOscillationFrequency; // 이전 계산된 진동수 사용
-    bool frequencyDetectedCongestion = (currentOscillationFrequency > m_congestionThreshold);
-    double currentRtt = tcb->m_lastRtt.Get().GetSeconds(); // 현재 RTT 가져오기
-    double maxRttThreshold = m_baseRtt.GetSeconds() * 1.2; // 최소 RTT에 기반한 동적 임계값
+template <typename Policies>
+bool TcpDoBase<Policies>::IsSpectralDetection() const
+{
+    return m_detector.IsSpectralDetection();
+}
 
-    if (vegasDetectedCongestion || frequencyDetectedCongestion || currentRtt > maxRttThreshold)
-    {
-        NS_LOG_INFO("Congestion detected by Vegas, Oscillation Frequency, or High RTT: Reducing cwnd");
+template <typename Policies>
+void TcpDoBase<Policies>::SetSpectralSamplePeriod(Time period)
+{
+    m_detector.SetSpectralSamplePeriod(period);
+}
 
-        uint32_t newCwnd;
-        double severity = currentOscillationFrequency / m_congestionThreshold;
+template <typename Policies>
+Time TcpDoBase<Policies>::GetSpectralSamplePeriod() const
+{
+    return m_detector.GetSpectralSamplePeriod();
+}
 
-        if (vegasDetectedCongestion || currentRtt > maxRttThreshold) 
-        {
-            // Vegas나 RTT 기반 혼잡 감지의 경우 약간 덜 공격적으로 감소
-            double reductionFactor = std::max(0.8, 1.0 - severity * 0.05);  // 혼잡이 심할수록 줄임 (최소 70%)
-            newCwnd = std::max(static_cast<uint32_t>(tcb->m_cWnd.Get() * reductionFactor), tcb->m_segmentSize * 10);
-        } 
-        else if (frequencyDetectedCongestion) 
-        {
-            // 진동수 기반 혼잡 감지의 경우 더 강하게 감소
-            double reductionFactor = std::max(0.7, 1.0 - severity * 0.15);  // 혼잡이 심할수록 더 줄임 (최소 50%)
-            newCwnd = std::max(static_cast<uint32_t>(tcb->m_cWnd.Get() * reductionFactor), tcb->m_segmentSize * 10);
-        }
+template <typename Policies>
+void TcpDoBase<Policies>::SetPerRttGrowth(bool enable)
+{
+    m_detector.SetPerRttGrowth(enable);
+}
+
+template <typename Policies>
+bool TcpDoBase<Policies>::IsPerRttGrowth() const
+{
+    return m_detector.IsPerRttGrowth();
+}
+
+template <typename Policies>
+void TcpDoBase<Policies>::SetGrowthScale(double scale)
+{
+    m_detector.SetGrowthScale(scale);
+}
+
+template <typename Policies>
+double TcpDoBase<Policies>::GetGrowthScale() const
+{
+    return m_detector.GetGrowthScale();
+}
+
+template <typename Policies>
+void TcpDoBase<Policies>::SetMaxRttGrowth(uint32_t segments)
+{
+    m_detector.SetMaxRttGrowth(segments);
+}
+
+template <typename Policies>
+uint32_t TcpDoBase<Policies>::GetMaxRttGrowth() const
+{
+    return m_detector.GetMaxRttGrowth();
+}
 
-        // 혼잡 후 빠르게 회복하기 위해 임계값을 일시적으로 증가
-        m_congestionThreshold *= std::min(2.0, 1.0 + severity * 0.2);
+template <typename Policies>
+void TcpDoBase<Policies>::SetEcnMode(TcpDoEcnMode mode)
+{
+    m_ecnResponse.SetMode(mode);
+}
+
+template <typename Policies>
+TcpDoEcnMode TcpDoBase<Policies>::GetEcnMode() const
+{
+    return m_ecnResponse.GetMode();
+}
+
+template <typename Policies>
+void TcpDoBase<Policies>::SetEcnGain(double gain)
+{
+    m_ecnResponse.SetGain(gain);
+}
+
+template <typename Policies>
+double TcpDoBase<Policies>::GetEcnGain() const
+{
+    return m_ecnResponse.GetGain();
+}
 
-        tcb->m_ssThresh = newCwnd;  // 혼잡 후 바로 선형 증가 모드로 진입
-        tcb->m_cWnd = newCwnd;
+template <typename Policies>
+void TcpDoBase<Policies>::Init(Ptr<TcpSocketState> tcb)
+{
+    TcpVegas::Init(tcb);
+
+    // ECN 반응이 켜져 있으면 연결 설정 시 ECN을 협상
+    if (m_ecnResponse.GetMode() != TCPDO_ECN_OFF)
+    {
+        tcb->m_useEcn = TcpSocketState::On;
     }
-    else
+    if (m_ecnResponse.GetMode() == TCPDO_ECN_DCTCP)
     {
-        NS_LOG_INFO("No congestion detected: Increasing cwnd cautiously");
+        // 수신자가 CE 표시된 세그먼트마다 ECE를 돌려주어야 표시 비율을 알 수 있음
+        tcb->m_ecnMode = TcpSocketState::DctcpEcn;
+    }
+}
 
-        if (currentOscillationFrequency == 0.0)
+template <typename Policies>
+void TcpDoBase<Policies>::PktsAcked(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time& rtt)
+{
+    // 표시된 바이트 비율은 복구 중에도 집계하고, 데이터 한 윈도우마다 alpha를 갱신
+    if (m_ecnResponse.GetMode() == TCPDO_ECN_DCTCP)
+    {
+        m_ecnResponse.OnAck(segmentsAcked * tcb->m_segmentSize, tcb->m_ecnState == TcpSocketState::ECN_ECE_RCVD);
+        if (tcb->m_lastAckedSeq >= m_ecnNextSeq)
         {
-            tcb->m_cWnd += tcb->m_segmentSize * 15;  // 더 공격적인 변동 유도
-            m_congestionThreshold *= 0.9;
-            NS_LOG_INFO("Reducing congestion threshold temporarily to induce change");
+            m_ecnResponse.EndWindow();
+            m_ecnNextSeq = tcb->m_highTxMark;
         }
+    }
 
-        double alpha = 1.0; 
-        double beta = 3.0;  
+    // Karn: 복구 중의 RTT 샘플은 재전송 세그먼트의 샘플과 구분할 수 없으므로 무시
+    if (m_inRecovery)
+    {
+        NS_LOG_INFO("In recovery: Ignoring RTT update to prevent oscillation");
+        return;
+    }
 
-        double diff = (tcb->m_cWnd.Get() - tcb->m_ssThresh.Get()) / tcb->m_segmentSize;
+    TcpVegas::PktsAcked(tcb, segmentsAcked, rtt);
 
-        if (diff < alpha)
-        {
-            tcb->m_cWnd += tcb->m_segmentSize * 7;  
-            NS_LOG_INFO("Minimal congestion detected: Slowly increasing cwnd by four segments");
-        }
-        else if (diff > beta)
-        {
-            tcb->m_cWnd -= tcb->m_segmentSize; 
-            NS_LOG_INFO("Heavy congestion detected: Decreasing cwnd by one segment");
-        }
-        else
-        {
-            uint32_t maxIncrease = std::max(1U, tcb->m_cWnd.Get() / 2);
-            tcb->m_cWnd = std::min(tcb->m_cWnd.Get() + maxIncrease, tcb->m_ssThresh.Get());
-            NS_LOG_INFO("Moderate congestion detected: Increasing cwnd moderately");
-        }
+    m_detector.OnRtt(Simulator::Now(), rtt);
+    UpdateTracedValues();
+}
+
+template <typename Policies>
+void TcpDoBase<Policies>::IncreaseWindow(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked)
+{
+    TcpDoWindow before = {tcb->m_cWnd.Get(), tcb->m_ssThresh.Get(), tcb->m_segmentSize};
+    TcpDoWindow window = before;
+    TcpDoDecisionDetail detail;
+    uint8_t decision = m_detector.UpdateWindow(Simulator::Now(), tcb->m_lastRtt.Get(), segmentsAcked, window, detail);
+    m_congestionThreshold = m_detector.GetCongestionThreshold();
+    m_windowDecision(decision);
+
+    // 감사 싱크가 연결된 경우에만 레코드를 구성
+    if (!m_audit.IsEmpty())
+    {
+        AuditDecision(decision, detail, before, window, tcb->m_lastRtt.Get(), m_detector.GetRttThreshold());
     }
+
+    tcb->m_ssThresh = window.ssThresh;
+    tcb->m_cWnd = window.cWnd;
 }
 
-void TcpDo::CalculateOscillationFrequency(const Time& rtt)
+template <typename Policies>
+uint32_t TcpDoBase<Policies>::GetSsThresh(Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight)
 {
-    static Time lastRtt = Time(0);
-    Time currentRtt = rtt;
+    TcpDoWindow window = {tcb->m_cWnd.Get(), tcb->m_ssThresh.Get(), tcb->m_segmentSize};
+    double referenceRtt = m_detector.GetReferenceRtt();
+    m_pendingLossSsThresh = 0;
+
+    // 손실 대응 (TcpDo는 Vegas의 값을 사용)
+    TcpDoDecisionDetail lossDetail;
+    uint32_t lossSsThresh;
+    bool lossResponse =
+        m_lossResponse.GetSsThresh(tcb->m_lastRtt.Get().GetSeconds(), referenceRtt, window, lossSsThresh, lossDetail);
+    if (!lossResponse)
+    {
+        lossSsThresh = TcpVegas::GetSsThresh(tcb, bytesInFlight);
+        lossDetail.causes = TCPDO_CAUSE_RETRANSMISSION;
+        lossDetail.severity = 0.0;
+        lossDetail.reductionFactor = window.cWnd > 0 ? static_cast<double>(lossSsThresh) / window.cWnd : 1.0;
+    }
 
-    // RTT 변화 감지
-    if (lastRtt != Time(0))
+    if (m_ecnResponse.GetMode() == TCPDO_ECN_OFF || tcb->m_ecnState != TcpSocketState::ECN_ECE_RCVD)
     {
-        double rttChange = (currentRtt - lastRtt).GetSeconds();
-        if (std::abs(rttChange) > 0.0001) 
+        if (lossResponse)
         {
-            // 변화가 발생할 때마다 진동 수를 증가
-            m_oscillationCount++;
+            ReportBackoff(lossDetail, window, lossSsThresh, tcb->m_lastRtt.Get(), referenceRtt);
         }
+        return lossSsThresh;
     }
 
-    lastRtt = currentRtt;
-
-    // 일정 시간 창(window) 동안의 진동 수를 계산
-    Time now = Simulator::Now();
-    if (now - m_lastCalculationTime >= m_timeWindow)
+    // ECE가 켜진 채로 손실이 날 수도 있음 (DCTCP 수신자는 CE마다 ECE를 돌려줌).
+    // 이미 복구/손실 상태이면 손실이 확실하므로 더 작은 값을 쓰고, 아니면 ECE에 의한 CWR일 수 있으므로
+    // ECN 감소를 적용하되 바로 이어서 복구/손실 상태로 들어가면 CongestionStateSet()에서 손실 값까지 낮춤
+    TcpDoDecisionDetail ecnDetail;
+    uint32_t ecnSsThresh;
+    m_ecnResponse.GetSsThresh(window, ecnSsThresh, ecnDetail);
+    if (lossSsThresh < ecnSsThresh)
     {
-        // 가중치를 적용한 진동수 계산
-        double weightedOscillationSum = 0.0;
-        double weightTotal = 0.0;
-        double weight = 1.0;
-        double weightIncrement = 0.1;
-
-        for (auto it = m_rttHistory.rbegin(); it != m_rttHistory.rend(); ++it)
+        if (m_inRecovery)
         {
-            double rttChange = std::abs((currentRtt - *it).GetSeconds());
-            if (rttChange > 0.0001) 
-            {
-                weightedOscillationSum += rttChange * weight;
-                weightTotal += weight;
-                weight += weightIncrement;
-            }
+            ReportBackoff(lossDetail, window, lossSsThresh, tcb->m_lastRtt.Get(), referenceRtt);
+            return lossSsThresh;
         }
+        m_pendingLossSsThresh = lossSsThresh;
+        m_pendingLossDetail = lossDetail;
+    }
+    ReportBackoff(ecnDetail, window, ecnSsThresh, tcb->m_lastRtt.Get(), referenceRtt);
+    return ecnSsThresh;
+}
 
-        m_lastOscillationFrequency = weightTotal > 0 ? weightedOscillationSum / weightTotal : 0;
+template <typename Policies>
+void TcpDoBase<Policies>::CongestionStateSet(Ptr<TcpSocketState> tcb,
+                                             const TcpSocketState::TcpCongState_t newState)
+{
+    TcpVegas::CongestionStateSet(tcb, newState);
 
-        // 다음 계산을 위해 초기화
-        m_oscillationCount = 0;
-        m_lastCalculationTime = now;
-    }
+    // 빠른 재전송 이후의 복구와 RTO 이후의 손실 상태 동안 RTT 샘플을 무시
+    m_inRecovery = (newState == TcpSocketState::CA_RECOVERY || newState == TcpSocketState::CA_LOSS);
 
-    m_rttHistory.push_back(rtt);
-    if (m_rttHistory.size() > m_maxRttHistorySize) 
+    // ECE와 함께 계산된 ssthresh 직후에 복구/손실 상태로 들어가면 손실이었으므로 손실 대응까지 낮춤
+    if (m_inRecovery && m_pendingLossSsThresh > 0 && m_pendingLossSsThresh < tcb->m_ssThresh)
     {
-        m_rttHistory.pop_front();
+        TcpDoWindow window = {tcb->m_cWnd.Get(), tcb->m_ssThresh.Get(), tcb->m_segmentSize};
+        ReportBackoff(m_pendingLossDetail, window, m_pendingLossSsThresh, tcb->m_lastRtt.Get(),
+                      m_detector.GetReferenceRtt());
+        tcb->m_ssThresh = m_pendingLossSsThresh;
     }
+    m_pendingLossSsThresh = 0;
+}
 
-    // 혼잡 감지 시 샘플 크기 증가, 안정적인 경우 샘플 크기 감소
-    if (m_lastOscillationFrequency > m_congestionThreshold)
-    {
-        m_maxRttHistorySize = std::min(static_cast<size_t>(50), m_maxRttHistorySize + 1); 
-    }
-    else
+template <typename Policies>
+void TcpDoBase<Policies>::ReportBackoff(TcpDoDecisionDetail detail,
+                                        const TcpDoWindow& before,
+                                        uint32_t ssThresh,
+                                        Time rtt,
+                                        double referenceRtt)
+{
+    m_windowDecision(TCPDO_BACKOFF);
+
+    if (!m_audit.IsEmpty())
     {
-        m_maxRttHistorySize = std::max(static_cast<size_t>(10), m_maxRttHistorySize - 1); 
+        // 손실/ECN 대응은 진동 지표를 보지 않으므로 검출기 상태를 그대로 기록
+        detail.oscillation = m_detector.GetLastOscillationFrequency();
+        detail.congestionThreshold = m_detector.GetCongestionThreshold();
+        TcpDoWindow after = before;
+        after.ssThresh = ssThresh;
+        AuditDecision(TCPDO_BACKOFF, detail, before, after, rtt, referenceRtt);
     }
 }
 
+template <typename Policies>
+void TcpDoBase<Policies>::AuditDecision(uint8_t decision,
+                                        const TcpDoDecisionDetail& detail,
+                                        const TcpDoWindow& before,
+                                        const TcpDoWindow& after,
+                                        Time rtt,
+                                        double rttThreshold)
+{
+    TcpDoAuditRecord record;
+    record.timeNs = Simulator::Now().GetNanoSeconds();
+    record.flowId = 0;
+    record.decision = decision;
+    record.causes = detail.causes;
+    record.reserved = 0;
+    record.cwndBefore = before.cWnd;
+    record.cwndAfter = after.cWnd;
+    record.ssThreshBefore = before.ssThresh;
+    record.ssThreshAfter = after.ssThresh;
+    record.severity = static_cast<float>(detail.severity);
+    record.reductionFactor = static_cast<float>(detail.reductionFactor);
+    record.oscillation = static_cast<float>(detail.oscillation);
+    record.congestionThreshold = static_cast<float>(detail.congestionThreshold);
+    record.rtt = static_cast<float>(rtt.GetSeconds());
+    record.rttThreshold = static_cast<float>(rttThreshold);
+    m_audit(record);
+}
+
+template class TcpDoBase<TcpDoPolicies>;
+template class TcpDoBase<TcpDoV1Policies>;
+
+TypeId TcpDo::GetTypeId(void)
+{
+    static TypeId tid = AddAttributes(TypeId("ns3::TcpDo")
+                                          .SetParent<TcpVegas>()
+                                          .SetGroupName("Internet")
+                                          .AddConstructor<TcpDo>(),
+                                      MilliSeconds(10));
+    return tid;
+}
+
+TcpDo::TcpDo()
+{
+}
+
+TcpDo::TcpDo(const TcpDo& sock)
+    : TcpDoBase<TcpDoPolicies>(sock)
+{
+}
+
+TcpDo::~TcpDo() {}
+
+std::string TcpDo::GetName() const
+{
+    return "TcpDo";
+}
+
+Ptr<TcpCongestionOps> TcpDo::Fork()
+{
+    return CopyObject<TcpDo>(this);
+}
+
+TypeId TcpDoV1::GetTypeId(void)
+{
+    static TypeId tid = AddAttributes(TypeId("ns3::TcpDoV1")
+                                          .SetParent<TcpVegas>()
+                                          .SetGroupName("Internet")
+                                          .AddConstructor<TcpDoV1>(),
+                                      MilliSeconds(100));
+    return tid;
+}
+
+TcpDoV1::TcpDoV1()
+{
+}
+
+TcpDoV1::TcpDoV1(const TcpDoV1& sock)
+    : TcpDoBase<TcpDoV1Policies>(sock)
+{
+}
+
+TcpDoV1::~TcpDoV1() {}
+
+std::string TcpDoV1::GetName() const
+{
+    return "TcpDoV1";
+}
+
+Ptr<TcpCongestionOps> TcpDoV1::Fork()
+{
+    return CopyObject<TcpDoV1>(this);
+}
 
 } // namespace ns3
@@ -1,56 +1,218 @@
 #ifndef TCP_DO_H
 #define TCP_DO_H
 
+#include "audit-record.h"
+#include "tcp-do-detector.h"
+
 #include "ns3/tcp-vegas.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
-#include <deque>
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
 
 namespace ns3 {
 
 /**
- * \brief TcpDo implements a custom TCP congestion control algorithm
- *        that combines elements of TCP Vegas with oscillation frequency-based
- *        congestion detection.
+ * \brief Congestion control shared by the TcpDo variants: TCP Vegas combined
+ *        with oscillation-based congestion detection.
+ *
+ * \p Policies selects the oscillation metric, the RTT threshold rule, the
+ * window policy and the loss response at compile time (see
+ * tcp-do-policies.h).  Each instantiation is a separate congestion control
+ * with its own TypeId, registered by the concrete subclasses below, and
+ * only the usual TcpCongestionOps virtual calls reach it.
+ *
+ * Losses reach TcpDo through the regular callbacks: ns-3 asks GetSsThresh()
+ * on every fast retransmit and RTO, where the LossResponse policy may pick
+ * the new threshold, and reports recovery and RTOs through
+ * CongestionStateSet().  RTT samples taken while in CA_RECOVERY or CA_LOSS
+ * are ignored (Karn's rule), since they cannot be told apart from samples of
+ * retransmitted segments and would otherwise inflate the oscillation metric.
+ *
+ * The detector state is exported as trace sources: OscillationFrequency,
+ * AdaptiveThreshold, RttHistorySize and BaseRtt as TracedValues, updated
+ * after every ACK, and the branch taken by every window update through
+ * WindowDecision.  With no sink connected they cost one comparison each.
+ *
+ * The Audit trace source reports every window update as a TcpDoAuditRecord:
+ * the branch, the congestion signals behind it, severity, reduction factor
+ * and cwnd/ssthresh before and after.  The record is only assembled while a
+ * sink is connected; FlowTracer connects every socket to the single
+ * AuditLog shared by all flows of the run.
+ *
+ * By default the window rules grow cwnd on every ACK, as in the original
+ * TcpDo.  PerRttGrowth makes every update that raises cwnd wait until a
+ * cwnd worth of bytes has been acknowledged and then apply one step, scaled by
+ * GrowthScale and capped at MaxRttGrowth segments, so that the growth rate
+ * no longer depends on the ACK rate or delayed ACKs.
+ *
+ * The window rules can add up to 15 segments at once; without pacing those
+ * leave back to back and arrive at the bottleneck as a single burst.  TcpDo
+ * leaves the pacing rate to the socket (TcpSocketState::EnablePacing), which
+ * recomputes it on every ACK from cwnd over the smoothed RTT, scaled by
+ * PacingSsRatio and PacingCaRatio.
+ *
+ * EcnMode makes CE marks a congestion signal next to the oscillation
+ * metric: the socket then negotiates ECN and, on the first ACK with ECE,
+ * GetSsThresh() takes the TcpDoEcnResponse instead of the loss response,
+ * either halving cwnd (Classic) or reducing it by half the smoothed
+ * fraction of marked bytes (Dctcp, which also asks the receiver to echo
+ * every CE mark).  Both reduce at most once per RTT.  The bottleneck queue
+ * disc has to mark rather than drop, e.g. with UseEcn and CeThreshold.
+ * ECE may still be set when a loss is detected, so a loss never gets less
+ * than the loss response: already in recovery the smaller threshold wins,
+ * and an ECN threshold followed by entering CA_RECOVERY or CA_LOSS is
+ * lowered to the loss response in CongestionStateSet().
+ *
+ * \tparam Policies TcpDoPolicies or TcpDoV1Policies
  */
-class TcpDo : public TcpVegas
+template <typename Policies>
+class TcpDoBase : public TcpVegas
 {
 public:
-    // Create TypeId for TcpDo
-    static TypeId GetTypeId(void);
+    /**
+     * TracedCallback signature for window decisions.
+     * \param [in] decision the TcpDoDecision taken, with or without TCPDO_PROBE
+     */
+    typedef void (*WindowDecisionTracedCallback)(uint8_t decision);
 
-    TcpDo(); // Default constructor
-    TcpDo(const TcpDo& sock); // Copy constructor
-    virtual ~TcpDo(); // Destructor
+    /**
+     * TracedCallback signature for the decision audit stream.
+     * \param [in] record the window update, with flowId left at zero
+     */
+    typedef void (*AuditTracedCallback)(const TcpDoAuditRecord& record);
 
-    virtual std::string GetName() const override;
+    TcpDoBase();
+    TcpDoBase(const TcpDoBase& sock);
+
+    // Override methods from TcpVegas
+    virtual void Init(Ptr<TcpSocketState> tcb) override;
+    virtual uint32_t GetSsThresh(Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight) override;
+    virtual void CongestionStateSet(Ptr<TcpSocketState> tcb,
+                                    const TcpSocketState::TcpCongState_t newState) override;
 
 protected:
     // Override methods from TcpVegas
     virtual void PktsAcked(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time& rtt) override;
     virtual void IncreaseWindow(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked) override;
 
-    // Method to adjust congestion threshold
-    void AdjustCongestionThreshold(double newThreshold);
+    /**
+     * \brief Register the attributes and trace sources shared by the variants.
+     * \param tid TypeId of the variant
+     * \param timeWindow default TimeWindow of the variant
+     * \return \p tid
+     */
+    static TypeId AddAttributes(TypeId tid, Time timeWindow);
+
+    // Attribute accessors forwarding to the detector
+    void SetCongestionThreshold(double threshold);
+    double GetCongestionThreshold() const;
+    void SetTimeWindow(Time window);
+    Time GetTimeWindow() const;
+    void SetMinRttHistorySize(uint32_t size);
+    uint32_t GetMinRttHistorySize() const;
+    void SetMaxRttHistorySize(uint32_t size);
+    uint32_t GetMaxRttHistorySize() const;
+    void SetSpectralDetection(bool enable);
+    bool IsSpectralDetection() const;
+    void SetSpectralSamplePeriod(Time period);
+    Time GetSpectralSamplePeriod() const;
+    void SetPerRttGrowth(bool enable);
+    bool IsPerRttGrowth() const;
+    void SetGrowthScale(double scale);
+    double GetGrowthScale() const;
+    void SetMaxRttGrowth(uint32_t segments);
+    uint32_t GetMaxRttGrowth() const;
+    void SetEcnMode(TcpDoEcnMode mode);
+    TcpDoEcnMode GetEcnMode() const;
+    void SetEcnGain(double gain);
+    double GetEcnGain() const;
 
 private:
-    // Calculate oscillation frequency based on RTT history
-    void CalculateOscillationFrequency(const Time& rtt);
+    // Copy the detector state into the traced values
+    void UpdateTracedValues();
+
+    // Report an ssthresh set by the loss or ECN response on WindowDecision and Audit
+    void ReportBackoff(TcpDoDecisionDetail detail,
+                       const TcpDoWindow& before,
+                       uint32_t ssThresh,
+                       Time rtt,
+                       double referenceRtt);
 
-    // Threshold for detecting congestion based on oscillation frequency
-    double m_congestionThreshold;
+    // Report a window update to the Audit trace source
+    void AuditDecision(uint8_t decision,
+                       const TcpDoDecisionDetail& detail,
+                       const TcpDoWindow& before,
+                       const TcpDoWindow& after,
+                       Time rtt,
+                       double rttThreshold);
 
-    // Last calculated oscillation frequency
-    double m_lastOscillationFrequency;
+    // Oscillation detection and window policy, shared with the offline tools
+    TcpDoDetector<Policies> m_detector;
 
-    // History of RTT samples for oscillation frequency calculation
-    std::deque<Time> m_rttHistory;
+    // Slow start threshold after losses
+    typename Policies::LossResponse m_lossResponse;
 
-    size_t m_maxRttHistorySize;
-    uint32_t m_oscillationCount;
-    Time m_timeWindow;
-    Time m_lastCalculationTime;                // 마지막으로 진동수가 계산된 시간
-    Time m_baseRtt;                            // 최소 RTT 값 (기준 RTT)
+    // True while in CA_RECOVERY or CA_LOSS, when RTT samples are ignored
+    bool m_inRecovery;
+
+    // Reaction to CE marks, off by default
+    TcpDoEcnResponse m_ecnResponse;
+
+    // End of the current DCTCP observation window
+    SequenceNumber32 m_ecnNextSeq;
+
+    // Loss response ssthresh held back by an ECE cut until the socket enters
+    // CA_RECOVERY or CA_LOSS, 0 if none
+    uint32_t m_pendingLossSsThresh;
+
+    // Causes and factor of m_pendingLossSsThresh
+    TcpDoDecisionDetail m_pendingLossDetail;
+
+    TracedValue<double> m_oscillationFrequency;      //!< Oscillation metric
+    TracedValue<double> m_congestionThreshold;       //!< Adaptive congestion threshold
+    TracedValue<uint32_t> m_rttHistorySize;          //!< Adaptive RTT history size
+    TracedValue<Time> m_baseRtt;                     //!< Smallest RTT seen
+    TracedCallback<uint8_t> m_windowDecision;        //!< Branch of every window update
+    TracedCallback<const TcpDoAuditRecord&> m_audit; //!< Decision audit stream
+};
+
+extern template class TcpDoBase<TcpDoPolicies>;
+extern template class TcpDoBase<TcpDoV1Policies>;
+
+/**
+ * \brief TcpDo: weighted RTT deviation evaluated once per time window, RTT
+ *        threshold at 1.2 times the base RTT, TcpVegas's loss response.
+ */
+class TcpDo : public TcpDoBase<TcpDoPolicies>
+{
+public:
+    // Create TypeId for TcpDo
+    static TypeId GetTypeId(void);
+
+    TcpDo(); // Default constructor
+    TcpDo(const TcpDo& sock); // Copy constructor
+    virtual ~TcpDo(); // Destructor
+
+    virtual std::string GetName() const override;
+    virtual Ptr<TcpCongestionOps> Fork() override;
+};
+
+/**
+ * \brief TcpDo v1: weighted RTT deviation on every ACK, RTT threshold at
+ *        mean plus 1.5 standard deviations, RTT-based loss response.
+ */
+class TcpDoV1 : public TcpDoBase<TcpDoV1Policies>
+{
+public:
+    static TypeId GetTypeId(void);
+
+    TcpDoV1();
+    TcpDoV1(const TcpDoV1& sock);
+    virtual ~TcpDoV1();
+
+    virtual std::string GetName() const override;
+    virtual Ptr<TcpCongestionOps> Fork() override;
 };
 
 } // namespace ns3
@@ -0,0 +1,1021 @@
+#include "audit-log.h"
+#include "flow-hash-routing.h"
+#include "flow-summary.h"
+#include "flow-tracer.h"
+#include "incast-workload.h"
+#include "parse-list.h"
+#include "throughput-monitor.h"
+#include "trace-sink.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/nix-vector-helper.h"
+#include "ns3/traffic-control-module.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <numeric>
+#include <vector>
+
+// Single scenario driver for the TCP congestion control comparisons.
+//
+// Every parameter that used to be hard-coded in the per-algorithm programs is
+// a command line option, so sweeps run against one prebuilt binary.  The old
+// programs map onto it as follows:
+//
+//   tcp-do-simulation, tcp-vegas-simulation (2-node point-to-point):
+//     --topology=p2p --delayModel=uniform --delayMin=20 --delayMax=80
+//     --appRate=2Gbps (Vegas: --onTime=ns3::ConstantRandomVariable[Constant=0.8]
+//     --offTime=ns3::ConstantRandomVariable[Constant=0.2])
+//   tcp-bbr-wired, tcp-cubic-wired, tcp-do-v1-simulation (sender - router -
+//   receiver; TcpDo v1 with --transport=TcpDoV1):
+//     --topology=dumbbell --nSenders=1 --delayModel=uniform --delayMin=0.5
+//     --delayMax=1.5 --appRate=1Gbps
+//     --onTime=ns3::ConstantRandomVariable[Constant=0.1]
+//     --offTime=ns3::ConstantRandomVariable[Constant=0.1]
+//   tcp-bbr-simulation, tcp-cubic-simulation (1 + 9 senders):
+//     --topology=dumbbell --nSenders=10 --delayModel=normal --delayMean=0.5
+//     --delayVariance=0.2 --bottleneckDelay=1 --appRate=300Mbps --lossRate=0.001
+//     --onTime=ns3::ExponentialRandomVariable[Mean=0.1]
+//     --offTime=ns3::ExponentialRandomVariable[Mean=0.2]
+//
+// The dumbbell scales to thousands of senders: addresses come from one /30
+// per sender without any string handling, and --routing=static (default)
+// installs a default route on every host instead of running global routing,
+// whose setup cost grows much faster than the node count.  --routing=global
+// and --routing=nix select ns-3's global or Nix-vector routing instead.
+// Every flow has its own PacketSink port from 8080 up, which limits a run to
+// 57456 OnOff senders.  Setup and run time and the peak resident memory are logged, e.g.
+//
+//   tcp-scenario --nSenders=10000 --simulationTime=3 --rawTrace=0
+//
+// Attributes of the congestion control itself can be set with the generic
+// ns-3 syntax, e.g. --ns3::TcpDo::CongestionThreshold=0.002, and the run
+// number with --RngRun.
+//
+// --flightRecorder keeps the raw samples in memory and only writes the last
+// --flightHistory before and --flightAfter after each trigger: a cwnd
+// reduction beyond --cwndDropTrigger, an RTO, or a goodput drop between bins
+// beyond --goodputDropTrigger.  Trigger records in the trace mark each dump.
+// The bottleneck queue length is traced under the id after the last flow id.
+//
+// --pacing paces every socket at --pacingGain times cwnd over the smoothed
+// RTT through the socket's PacingSsRatio and PacingCaRatio, for TcpDo and
+// TcpDoV1 as for the stock congestion controls.
+// Compare queue-<prefix>.csv (mean and maximum bottleneck queue, drops) and
+// the RTT percentiles of summary-<prefix>.csv with --pacing=0 and 1.
+//
+// --aqm replaces the queue disc on the bottleneck device: FqCoDel, CoDel,
+// Pie, Red, PfifoFast or any other <name>QueueDisc, "none" for the bare
+// drop-tail device queue, "default" (the default) for what ns-3 installs.
+// Queue disc attributes use the generic syntax, e.g.
+// --ns3::CoDelQueueDisc::Target=2ms.  The bottleneck backlog, sojourn times
+// and drops go to the trace as queue, sojourn and drop records.
+//
+// --ecn=Classic or --ecn=Dctcp negotiates ECN on every socket, sets the
+// EcnMode of TcpDo and TcpDoV1 and turns on marking in the --aqm queue disc
+// (FqCoDel for "default", the queue disc ns-3 installs; "none" cannot mark);
+// --ceThreshold marks above a sojourn time instead of at the AQM's own
+// target (CoDel and FqCoDel), which the Dctcp mode expects:
+//
+//   tcp-scenario --transport=TcpDo --aqm=FqCoDel --ecn=Dctcp --ceThreshold=1ms
+//
+// --topology=parkinglot chains --hops routers: the --nSenders long flows
+// enter at the first router and cross every hop to the receiver, and at
+// each hop --crossFlows senders enter and leave after that single hop.
+// --hopRate and --hopDelay take one value for all hops or a comma separated
+// value per hop; access links use --dataRate and the delay model.  Every
+// hop queue gets the --aqm and is traced (ids after the last flow id),
+// paths-<prefix>.csv lists the hops and goodput of every flow, and the
+// mean goodput of the long flows is logged against the cross traffic of
+// each hop, e.g. to compare the RTT bias of TcpDo with TcpCubic and TcpBbr:
+//
+//   tcp-scenario --topology=parkinglot --hops=4 --nSenders=2 --crossFlows=2
+//     --hopRate=100Mbps --hopDelay=5 --transport=TcpDo
+//
+// --topology=fattree builds a k-ary fat-tree (--fatTreeK, k^3/4 hosts):
+// host 0 is the receiver, every other host a sender, and the bottleneck is
+// the edge switch port in front of host 0.  Host links run at --dataRate,
+// switch links at --bottleneckRate.  --routing=static installs per-flow
+// ECMP: edge and aggregation switches hash the addresses and ports of each
+// flow over all of their up-links (FlowHashRouting), so a flow keeps its
+// path and is never reordered while the flows towards one host spread over
+// every aggregation and core switch; down-links use static routes.
+// --routing=global uses shortest paths (add
+// --ns3::Ipv4GlobalRouting::RandomEcmpRouting=1 for per-packet ECMP).
+//
+// --workload=incast replaces the OnOff flows by partition/aggregate queries:
+// the receiver sends a --requestSize byte request to --fanIn random senders,
+// each answers with --responseSize bytes, and once all responses are in it
+// issues the next query --queryGap later, until --queries have been issued.
+// Percentiles of the query completion time, which covers the request and
+// the responses, and the RTOs are logged, and every query goes to
+// queries-<prefix>.csv.  Worker sockets are traced as flows 0 to
+// nSenders - 1, so --rawTrace, --flightRecorder and --audit work as with
+// the OnOff flows.  At datacenter scale the RTO floor and TcpDo's time
+// window must shrink too, e.g.
+//
+//   tcp-scenario --topology=fattree --workload=incast --fanIn=15
+//     --dataRate=10Gbps --bottleneckRate=10Gbps --delayModel=constant
+//     --delay=0.002 --ns3::TcpSocketBase::MinRto=1ms
+//     --ns3::TcpDo::TimeWindow=50us
+//
+// --audit writes every TcpDo window decision to audit-<prefix>.bin; decode
+// it with tcp-do-audit-convert, which can line decisions up with the goodput
+// bins of trace-<prefix>.bin.
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpScenario");
+
+const uint16_t SINK_BASE_PORT = 8080;                    //!< PacketSink port of sender 0
+const uint32_t MAX_SINK_PORTS = 65536 - SINK_BASE_PORT; //!< Senders with a distinct sink port
+
+/**
+ * Scenario parameters, filled from the command line.
+ */
+struct ScenarioConfig
+{
+    std::string transport = "TcpDo";    //!< Congestion control TypeId name
+    std::string topology = "dumbbell";  //!< "p2p", "dumbbell", "fattree" or "parkinglot"
+    uint32_t nSenders = 10;             //!< Senders in the dumbbell, long flows in the parking lot
+    uint32_t hops = 3;                  //!< Router hops of the parking lot
+    std::string hopRate = "1Gbps";      //!< Parking lot hop rates, one for all or one per hop
+    std::string hopDelay = "1";         //!< Parking lot hop delays in ms, one for all or one per hop
+    uint32_t crossFlows = 1;            //!< Cross-traffic senders per parking lot hop
+    uint32_t fatTreeK = 4;              //!< Switch ports of the fat-tree, even
+    std::string workload = "onoff";     //!< "onoff" or "incast"
+    IncastWorkload::Settings incast;    //!< Fan-in, response size and queries of the incast workload
+    std::string dataRate = "1Gbps";     //!< Access link rate
+    std::string bottleneckRate = "1Gbps"; //!< Router to receiver link rate
+    std::string routing = "static";     //!< "static", "global" or "nix"
+    std::string aqm = "default";        //!< Bottleneck queue disc, "none" or "default"
+    std::string ecn = "Off";            //!< "Off", "Classic" or "Dctcp"
+    Time ceThreshold = Seconds(0);      //!< Sojourn time above which the AQM marks, 0 for its default
+    std::string delayModel = "uniform"; //!< "constant", "uniform" or "normal"
+    double delay = 1.0;                 //!< Constant access delay, ms
+    double delayMin = 0.5;              //!< Uniform lower bound, ms
+    double delayMax = 1.5;              //!< Uniform upper bound, ms
+    double delayMean = 0.5;             //!< Normal mean, ms
+    double delayVariance = 0.2;         //!< Normal variance, ms^2
+    double bottleneckDelay = -1.0;      //!< Bottleneck delay in ms, < 0 draws from the delay model
+    double lossRate = 0.0;              //!< Packet error rate at the receiver
+    std::string appRate = "1Gbps";      //!< OnOff data rate per sender
+    uint32_t packetSize = 1024;         //!< OnOff packet size
+    std::string onTime = "ns3::ConstantRandomVariable[Constant=1.0]";  //!< OnOff on time
+    std::string offTime = "ns3::ConstantRandomVariable[Constant=0.0]"; //!< OnOff off time
+    double simulationTime = 20.0;       //!< Simulation time, s
+    Time throughputBin = Seconds(1.0);  //!< Width of a goodput bin
+    bool rawTrace = true;               //!< Also write every sample to the binary trace
+    bool flightRecorder = false;        //!< Only write raw samples around trigger events
+    FlightRecorderSettings flight;      //!< Flight recorder history and triggers
+    bool audit = false;                 //!< Write the TcpDo decision audit stream
+    bool pacing = false;                //!< Pace the senders' sockets
+    double pacingGain = 1.0;            //!< Pacing rate over cwnd / smoothed RTT
+    uint32_t seed = 1;                  //!< RngSeed
+    std::string prefix;                 //!< Output file prefix, derived if empty
+};
+
+/**
+ * Nodes and addresses shared by every topology.
+ */
+struct ScenarioTopology
+{
+    NodeContainer senders;                  //!< Sender nodes, one flow each
+    Ptr<Node> receiver;                     //!< Node hosting every PacketSink unless sinks is set
+    Ipv4Address receiverAddress;            //!< Address the senders connect to
+    NetDeviceContainer bottleneck;          //!< Devices of the bottleneck link, downstream side second
+    Ptr<NetDevice> receiverDevice;          //!< Receiver's device, where --lossRate drops packets
+    NodeContainer sinks;                    //!< Receiving node per sender, receiver for all if empty
+    std::vector<Ipv4Address> sinkAddresses; //!< Address per sender, receiverAddress for all if empty
+    NetDeviceContainer hops;                //!< Transmitting device of every router hop, parking lot only
+    std::vector<uint32_t> senderFirstHop;   //!< First router hop per sender, parking lot only
+    std::vector<uint32_t> senderHops;       //!< Router hops crossed per sender, parking lot only
+};
+
+// 설정된 분포에 따라 링크 지연을 생성하는 난수 변수
+Ptr<RandomVariableStream> CreateDelayVariable(const ScenarioConfig& config)
+{
+    if (config.delayModel == "uniform")
+    {
+        Ptr<UniformRandomVariable> delayVar = CreateObject<UniformRandomVariable>();
+        delayVar->SetAttribute("Min", DoubleValue(config.delayMin));
+        delayVar->SetAttribute("Max", DoubleValue(config.delayMax));
+        return delayVar;
+    }
+    if (config.delayModel == "normal")
+    {
+        Ptr<NormalRandomVariable> delayVar = CreateObject<NormalRandomVariable>();
+        delayVar->SetAttribute("Mean", DoubleValue(config.delayMean));
+        delayVar->SetAttribute("Variance", DoubleValue(config.delayVariance));
+        return delayVar;
+    }
+    NS_ABORT_MSG_UNLESS(config.delayModel == "constant", "Unknown delay model: " << config.delayModel);
+    Ptr<ConstantRandomVariable> delayVar = CreateObject<ConstantRandomVariable>();
+    delayVar->SetAttribute("Constant", DoubleValue(config.delay));
+    return delayVar;
+}
+
+// 병목 장치의 루트 큐 디스크를 설정된 AQM으로 교체
+void InstallBottleneckQueueDisc(const ScenarioConfig& config, Ptr<NetDevice> device)
+{
+    if (config.aqm == "default")
+    {
+        return;
+    }
+
+    TrafficControlHelper trafficControl;
+    Ptr<TrafficControlLayer> layer = device->GetNode()->GetObject<TrafficControlLayer>();
+    if (layer && layer->GetRootQueueDiscOnDevice(device))
+    {
+        trafficControl.Uninstall(device);
+    }
+    if (config.aqm == "none")
+    {
+        return;
+    }
+
+    std::string queueDisc = "ns3::" + config.aqm + "QueueDisc";
+    TypeId queueDiscTypeId;
+    NS_ABORT_MSG_UNLESS(TypeId::LookupByNameFailSafe(queueDisc, &queueDiscTypeId), "Unknown AQM: " << config.aqm);
+    trafficControl.SetRootQueueDisc(queueDisc);
+    trafficControl.Install(device);
+}
+
+// 음수 지연이 나오지 않도록 0 이상으로 제한
+Time DrawDelay(Ptr<RandomVariableStream> delayVar)
+{
+    return MicroSeconds(static_cast<int64_t>(std::max(0.0, delayVar->GetValue()) * 1000));
+}
+
+// sender와 receiver를 직접 연결하는 포인트 투 포인트 토폴로지
+ScenarioTopology BuildPointToPoint(const ScenarioConfig& config, Ptr<RandomVariableStream> delayVar)
+{
+    ScenarioTopology topology;
+    topology.senders.Create(1);
+    topology.receiver = CreateObject<Node>();
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue(config.dataRate));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(DrawDelay(delayVar)));
+    topology.bottleneck = pointToPoint.Install(topology.senders.Get(0), topology.receiver);
+
+    InternetStackHelper stack;
+    stack.Install(topology.senders);
+    stack.Install(topology.receiver);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(topology.bottleneck);
+    topology.receiverAddress = interfaces.GetAddress(1);
+    topology.receiverDevice = topology.bottleneck.Get(1);
+
+    return topology;
+}
+
+// 프로세스의 최대 상주 메모리 (MB)
+double GetPeakRssMb()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0; // Linux에서 ru_maxrss는 KB 단위
+}
+
+// 라우팅 설정에 맞는 인터넷 스택 (static과 global은 기본 라우팅 헬퍼를 사용)
+InternetStackHelper CreateInternetStack(const ScenarioConfig& config)
+{
+    InternetStackHelper stack;
+    if (config.routing == "nix")
+    {
+        Ipv4NixVectorHelper nixRouting;
+        stack.SetRoutingHelper(nixRouting);
+    }
+    else
+    {
+        NS_ABORT_MSG_UNLESS(config.routing == "static" || config.routing == "global",
+                            "Unknown routing: " << config.routing);
+    }
+    return stack;
+}
+
+// N개의 sender가 router를 거쳐 하나의 receiver로 향하는 덤벨 토폴로지
+ScenarioTopology BuildDumbbell(const ScenarioConfig& config, Ptr<RandomVariableStream> delayVar)
+{
+    ScenarioTopology topology;
+    topology.senders.Create(config.nSenders);
+    topology.receiver = CreateObject<Node>();
+    Ptr<Node> router = CreateObject<Node>();
+
+    InternetStackHelper stack = CreateInternetStack(config);
+    stack.Install(topology.senders);
+    stack.Install(topology.receiver);
+    stack.Install(router);
+
+    PointToPointHelper accessLink;
+    accessLink.SetDeviceAttribute("DataRate", StringValue(config.dataRate));
+
+    // 송신자마다 /30 서브넷을 할당 (10.0.0.0/30 계획은 2^22 - 2^14개까지 가능하지만
+    // 모든 PacketSink가 receiver 한 주소의 포트를 나눠 쓰므로 포트 수가 실제 한계이며, main에서 확인)
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.252");
+    std::vector<Ipv4Address> senderGateways;
+    senderGateways.reserve(topology.senders.GetN());
+    for (uint32_t i = 0; i < topology.senders.GetN(); ++i)
+    {
+        accessLink.SetChannelAttribute("Delay", TimeValue(DrawDelay(delayVar)));
+        NetDeviceContainer senderToRouter = accessLink.Install(topology.senders.Get(i), router);
+        senderGateways.push_back(address.Assign(senderToRouter).GetAddress(1));
+        address.NewNetwork();
+    }
+
+    // 공유 링크 설정: router에서 receiver까지
+    Time bottleneckDelay = config.bottleneckDelay < 0 ? DrawDelay(delayVar)
+                                                      : MicroSeconds(static_cast<int64_t>(config.bottleneckDelay * 1000));
+    PointToPointHelper sharedLink;
+    sharedLink.SetDeviceAttribute("DataRate", StringValue(config.bottleneckRate));
+    sharedLink.SetChannelAttribute("Delay", TimeValue(bottleneckDelay));
+    topology.bottleneck = sharedLink.Install(router, topology.receiver);
+
+    address.SetBase("10.255.0.0", "255.255.255.0");
+    Ipv4InterfaceContainer routerReceiverInterfaces = address.Assign(topology.bottleneck);
+    topology.receiverAddress = routerReceiverInterfaces.GetAddress(1);
+    topology.receiverDevice = topology.bottleneck.Get(1);
+
+    if (config.routing == "global")
+    {
+        Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    }
+    else if (config.routing == "static")
+    {
+        // router는 연결된 서브넷 경로만으로 충분하므로 호스트에 기본 경로만 설정
+        // (인터페이스 0은 루프백, 1은 유일한 point-to-point 장치)
+        Ipv4StaticRoutingHelper staticRouting;
+        for (uint32_t i = 0; i < topology.senders.GetN(); ++i)
+        {
+            staticRouting.GetStaticRouting(topology.senders.Get(i)->GetObject<Ipv4>())
+                ->SetDefaultRoute(senderGateways[i], 1);
+        }
+        staticRouting.GetStaticRouting(topology.receiver->GetObject<Ipv4>())
+            ->SetDefaultRoute(routerReceiverInterfaces.GetAddress(0), 1);
+    }
+
+    return topology;
+}
+
+// 노드의 라우팅 목록에 정적 라우팅보다 먼저 조회되는 플로우 해시 ECMP를 추가
+Ptr<FlowHashRouting> InstallFlowHashRouting(Ptr<Node> node)
+{
+    Ptr<Ipv4ListRouting> list = DynamicCast<Ipv4ListRouting>(node->GetObject<Ipv4>()->GetRoutingProtocol());
+    NS_ABORT_MSG_UNLESS(list, "Node " << node->GetId() << " has no Ipv4ListRouting");
+    Ptr<FlowHashRouting> routing = CreateObject<FlowHashRouting>();
+    list->AddRoutingProtocol(routing, 10);
+    return routing;
+}
+
+/**
+ * Next hop of a fat-tree switch over one of its links.
+ */
+struct FatTreeHop
+{
+    Ipv4Address nextHop; //!< Address of the far end of the link
+    uint32_t interface;  //!< Interface index of the link on the near end
+};
+
+// 호스트 링크가 속한 edge 스위치의 /24 (10.<pod>.<edge>.0)
+Ipv4Address GetFatTreeEdgePrefix(uint32_t pod, uint32_t edge)
+{
+    return Ipv4Address((10u << 24) | (pod << 16) | (edge << 8));
+}
+
+// k-ary fat-tree: pod k개에 edge와 aggregation 스위치가 k/2개씩, core 스위치 (k/2)^2개,
+// 호스트 k^3/4개. 호스트 0이 receiver, 나머지 호스트가 모두 sender
+ScenarioTopology BuildFatTree(const ScenarioConfig& config, Ptr<RandomVariableStream> delayVar)
+{
+    uint32_t k = config.fatTreeK;
+    NS_ABORT_MSG_UNLESS(k >= 2 && k <= 64 && k % 2 == 0, "--fatTreeK must be even and between 2 and 64");
+    uint32_t half = k / 2;
+    uint32_t nHosts = k * half * half;
+
+    NodeContainer hosts;
+    NodeContainer edges;
+    NodeContainer aggs;
+    NodeContainer cores;
+    hosts.Create(nHosts);
+    edges.Create(k * half);
+    aggs.Create(k * half);
+    cores.Create(half * half);
+
+    InternetStackHelper stack = CreateInternetStack(config);
+    stack.Install(hosts);
+    stack.Install(edges);
+    stack.Install(aggs);
+    stack.Install(cores);
+
+    ScenarioTopology topology;
+    topology.receiver = hosts.Get(0);
+    for (uint32_t host = 1; host < nHosts; ++host)
+    {
+        topology.senders.Add(hosts.Get(host));
+    }
+
+    // 호스트 링크는 edge마다 10.<pod>.<edge>.0/24 안의 /30을 사용하여
+    // 상위 스위치가 edge 단위 /24, pod 단위 /16 경로로 호스트를 찾도록 함
+    PointToPointHelper hostLink;
+    hostLink.SetDeviceAttribute("DataRate", StringValue(config.dataRate));
+    std::vector<Ipv4Address> hostAddresses(nHosts);
+    std::vector<Ipv4Address> hostGateways(nHosts);
+    Ipv4AddressHelper address;
+    for (uint32_t edge = 0; edge < edges.GetN(); ++edge)
+    {
+        address.SetBase(GetFatTreeEdgePrefix(edge / half, edge % half), Ipv4Mask("255.255.255.252"));
+        for (uint32_t i = 0; i < half; ++i)
+        {
+            uint32_t host = edge * half + i;
+            hostLink.SetChannelAttribute("Delay", TimeValue(DrawDelay(delayVar)));
+            NetDeviceContainer devices = hostLink.Install(hosts.Get(host), edges.Get(edge));
+            Ipv4InterfaceContainer interfaces = address.Assign(devices);
+            hostAddresses[host] = interfaces.GetAddress(0);
+            hostGateways[host] = interfaces.GetAddress(1);
+            address.NewNetwork();
+
+            if (host == 0)
+            {
+                // incast가 몰리는 receiver 앞 edge 포트가 병목 (edge 쪽 장치가 먼저)
+                topology.bottleneck.Add(devices.Get(1));
+                topology.bottleneck.Add(devices.Get(0));
+                topology.receiverDevice = devices.Get(0);
+            }
+        }
+    }
+    topology.receiverAddress = hostAddresses[0];
+
+    // 스위치 사이 링크는 172.16.0.0/12에서 /30씩 할당
+    //   edgeUp[edge * half + j]: edge에서 같은 pod의 aggregation j로
+    //   aggDown[agg * half + e]: aggregation에서 같은 pod의 edge e로
+    //   aggUp[agg * half + j]: pod 안의 aggregation a에서 core a * half + j로
+    //   coreDown[core * k + pod]: core에서 pod의 aggregation core / half로
+    PointToPointHelper fabricLink;
+    fabricLink.SetDeviceAttribute("DataRate", StringValue(config.bottleneckRate));
+    std::vector<FatTreeHop> edgeUp(k * half * half);
+    std::vector<FatTreeHop> aggDown(k * half * half);
+    std::vector<FatTreeHop> aggUp(k * half * half);
+    std::vector<FatTreeHop> coreDown(half * half * k);
+    address.SetBase("172.16.0.0", "255.255.255.252");
+    for (uint32_t pod = 0; pod < k; ++pod)
+    {
+        for (uint32_t e = 0; e < half; ++e)
+        {
+            for (uint32_t a = 0; a < half; ++a)
+            {
+                uint32_t edge = pod * half + e;
+                uint32_t agg = pod * half + a;
+                fabricLink.SetChannelAttribute("Delay", TimeValue(DrawDelay(delayVar)));
+                NetDeviceContainer devices = fabricLink.Install(edges.Get(edge), aggs.Get(agg));
+                Ipv4InterfaceContainer interfaces = address.Assign(devices);
+                edgeUp[edge * half + a] = FatTreeHop{interfaces.GetAddress(1), interfaces.Get(0).second};
+                aggDown[agg * half + e] = FatTreeHop{interfaces.GetAddress(0), interfaces.Get(1).second};
+                address.NewNetwork();
+            }
+        }
+        for (uint32_t a = 0; a < half; ++a)
+        {
+            for (uint32_t j = 0; j < half; ++j)
+            {
+                uint32_t agg = pod * half + a;
+                uint32_t core = a * half + j;
+                fabricLink.SetChannelAttribute("Delay", TimeValue(DrawDelay(delayVar)));
+                NetDeviceContainer devices = fabricLink.Install(aggs.Get(agg), cores.Get(core));
+                Ipv4InterfaceContainer interfaces = address.Assign(devices);
+                aggUp[agg * half + j] = FatTreeHop{interfaces.GetAddress(1), interfaces.Get(0).second};
+                coreDown[core * k + pod] = FatTreeHop{interfaces.GetAddress(0), interfaces.Get(1).second};
+                address.NewNetwork();
+            }
+        }
+    }
+
+    if (config.routing == "global")
+    {
+        Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    }
+    else if (config.routing == "static")
+    {
+        // 내려가는 경로와 core는 목적지 edge별 정적 경로, 올라가는 경로는 edge와 aggregation이
+        // 플로우 해시로 모든 상위 링크에 분산 (플로우마다 경로가 고정되어 재정렬이 없음)
+        Ipv4StaticRoutingHelper staticRouting;
+        Ipv4Mask edgeMask("255.255.255.0");
+        for (uint32_t host = 0; host < nHosts; ++host)
+        {
+            staticRouting.GetStaticRouting(hosts.Get(host)->GetObject<Ipv4>())->SetDefaultRoute(hostGateways[host], 1);
+        }
+        for (uint32_t edge = 0; edge < edges.GetN(); ++edge)
+        {
+            Ptr<FlowHashRouting> routing = InstallFlowHashRouting(edges.Get(edge));
+            for (uint32_t target = 0; target < edges.GetN(); ++target)
+            {
+                for (uint32_t a = 0; target != edge && a < half; ++a)
+                {
+                    const FatTreeHop& up = edgeUp[edge * half + a];
+                    routing->AddNetworkRouteTo(GetFatTreeEdgePrefix(target / half, target % half), edgeMask,
+                                               up.nextHop, up.interface);
+                }
+            }
+        }
+        for (uint32_t agg = 0; agg < aggs.GetN(); ++agg)
+        {
+            Ptr<Ipv4StaticRouting> down = staticRouting.GetStaticRouting(aggs.Get(agg)->GetObject<Ipv4>());
+            Ptr<FlowHashRouting> up = InstallFlowHashRouting(aggs.Get(agg));
+            for (uint32_t target = 0; target < edges.GetN(); ++target)
+            {
+                Ipv4Address prefix = GetFatTreeEdgePrefix(target / half, target % half);
+                if (target / half == agg / half)
+                {
+                    const FatTreeHop& hop = aggDown[agg * half + target % half];
+                    down->AddNetworkRouteTo(prefix, edgeMask, hop.nextHop, hop.interface);
+                    continue;
+                }
+                for (uint32_t j = 0; j < half; ++j)
+                {
+                    const FatTreeHop& hop = aggUp[agg * half + j];
+                    up->AddNetworkRouteTo(prefix, edgeMask, hop.nextHop, hop.interface);
+                }
+            }
+        }
+        for (uint32_t core = 0; core < cores.GetN(); ++core)
+        {
+            Ptr<Ipv4StaticRouting> routing = staticRouting.GetStaticRouting(cores.Get(core)->GetObject<Ipv4>());
+            for (uint32_t pod = 0; pod < k; ++pod)
+            {
+                const FatTreeHop& down = coreDown[core * k + pod];
+                routing->AddNetworkRouteTo(GetFatTreeEdgePrefix(pod, 0), Ipv4Mask("255.255.0.0"), down.nextHop,
+                                           down.interface);
+            }
+        }
+    }
+
+    return topology;
+}
+
+// 호스트를 라우터에 연결하고 주소를 할당 (호스트 쪽 주소가 0번, 라우터 쪽이 1번)
+Ipv4InterfaceContainer AttachHost(PointToPointHelper& link,
+                                  Ipv4AddressHelper& address,
+                                  Ptr<Node> host,
+                                  Ptr<Node> router,
+                                  Ptr<RandomVariableStream> delayVar)
+{
+    link.SetChannelAttribute("Delay", TimeValue(DrawDelay(delayVar)));
+    Ipv4InterfaceContainer interfaces = address.Assign(link.Install(host, router));
+    address.NewNetwork();
+    return interfaces;
+}
+
+// 라우터 R0..RN을 일렬로 연결한 parking lot: 긴 플로우는 R0에서 RN 뒤의 receiver까지 모든 홉을,
+// 홉 i의 교차 트래픽은 Ri에서 R(i+1) 뒤의 교차 receiver까지 한 홉만 지남
+ScenarioTopology BuildParkingLot(const ScenarioConfig& config, Ptr<RandomVariableStream> delayVar)
+{
+    uint32_t nHops = config.hops;
+    NS_ABORT_MSG_UNLESS(nHops >= 1 && nHops <= 250, "--hops must be between 1 and 250");
+    std::vector<std::string> hopRates = ParseList<std::string>(config.hopRate);
+    std::vector<double> hopDelays = ParseList<double>(config.hopDelay);
+    NS_ABORT_MSG_UNLESS(hopRates.size() == 1 || hopRates.size() == nHops, "--hopRate needs one rate or one per hop");
+    NS_ABORT_MSG_UNLESS(hopDelays.size() == 1 || hopDelays.size() == nHops,
+                        "--hopDelay needs one delay or one per hop");
+    // R0에는 긴 플로우와 홉 0의 교차 sender가, R1..RN에는 교차 sender와 교차 receiver가 붙음
+    NS_ABORT_MSG_IF(config.nSenders + config.crossFlows >= (1u << 14) || config.crossFlows + 1 >= (1u << 14),
+                    "Too many hosts per router for the 10.<router>.0.0/16 plan: nSenders + crossFlows and "
+                    "crossFlows + 1 must stay below " << (1u << 14));
+
+    ScenarioTopology topology;
+    topology.senders.Create(config.nSenders + nHops * config.crossFlows);
+    topology.receiver = CreateObject<Node>();
+    NodeContainer crossReceivers;
+    crossReceivers.Create(nHops);
+    NodeContainer routers;
+    routers.Create(nHops + 1);
+
+    InternetStackHelper stack = CreateInternetStack(config);
+    stack.Install(topology.senders);
+    stack.Install(topology.receiver);
+    stack.Install(crossReceivers);
+    stack.Install(routers);
+
+    // 라우터 m에 붙는 호스트는 10.m.0.0/16 안의 /30을 사용하여 라우터끼리는 /16 경로만 주고받음
+    std::vector<Ipv4AddressHelper> hostAddress(nHops + 1);
+    for (uint32_t m = 0; m <= nHops; ++m)
+    {
+        hostAddress[m].SetBase(Ipv4Address((10u << 24) | (m << 16)), Ipv4Mask("255.255.255.252"));
+    }
+    PointToPointHelper accessLink;
+    accessLink.SetDeviceAttribute("DataRate", StringValue(config.dataRate));
+
+    // 긴 플로우 sender가 먼저, 이어서 홉 순서대로 교차 트래픽 sender
+    std::vector<Ipv4Address> hostGateways;
+    for (uint32_t i = 0; i < topology.senders.GetN(); ++i)
+    {
+        bool crossing = i >= config.nSenders;
+        uint32_t firstHop = crossing ? (i - config.nSenders) / config.crossFlows : 0;
+        topology.senderFirstHop.push_back(firstHop);
+        topology.senderHops.push_back(crossing ? 1 : nHops);
+        hostGateways.push_back(
+            AttachHost(accessLink, hostAddress[firstHop], topology.senders.Get(i), routers.Get(firstHop), delayVar)
+                .GetAddress(1));
+    }
+    Ipv4InterfaceContainer receiverInterfaces =
+        AttachHost(accessLink, hostAddress[nHops], topology.receiver, routers.Get(nHops), delayVar);
+    topology.receiverAddress = receiverInterfaces.GetAddress(0);
+    topology.receiverDevice = receiverInterfaces.Get(0).first->GetNetDevice(receiverInterfaces.Get(0).second);
+    hostGateways.push_back(receiverInterfaces.GetAddress(1));
+    std::vector<Ipv4Address> crossAddresses;
+    for (uint32_t i = 0; i < nHops; ++i)
+    {
+        Ipv4InterfaceContainer interfaces =
+            AttachHost(accessLink, hostAddress[i + 1], crossReceivers.Get(i), routers.Get(i + 1), delayVar);
+        crossAddresses.push_back(interfaces.GetAddress(0));
+        hostGateways.push_back(interfaces.GetAddress(1));
+    }
+    for (uint32_t i = 0; i < topology.senders.GetN(); ++i)
+    {
+        bool crossing = i >= config.nSenders;
+        topology.sinks.Add(crossing ? crossReceivers.Get(topology.senderFirstHop[i]) : topology.receiver);
+        topology.sinkAddresses.push_back(crossing ? crossAddresses[topology.senderFirstHop[i]]
+                                                  : topology.receiverAddress);
+    }
+
+    // 라우터 사이 홉: 홉마다 용량과 지연을 따로 지정 가능, 마지막 홉이 receiver 앞의 병목
+    Ipv4AddressHelper hopAddress;
+    hopAddress.SetBase("10.255.0.0", "255.255.255.252");
+    std::vector<Ipv4InterfaceContainer> hopInterfaces;
+    for (uint32_t i = 0; i < nHops; ++i)
+    {
+        PointToPointHelper hopLink;
+        hopLink.SetDeviceAttribute("DataRate", StringValue(hopRates[hopRates.size() == 1 ? 0 : i]));
+        double delay = hopDelays[hopDelays.size() == 1 ? 0 : i];
+        hopLink.SetChannelAttribute("Delay", TimeValue(MicroSeconds(static_cast<int64_t>(delay * 1000))));
+        NetDeviceContainer devices = hopLink.Install(routers.Get(i), routers.Get(i + 1));
+        hopInterfaces.push_back(hopAddress.Assign(devices));
+        hopAddress.NewNetwork();
+        topology.hops.Add(devices.Get(0));
+        topology.bottleneck = devices;
+    }
+
+    if (config.routing == "global")
+    {
+        Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    }
+    else if (config.routing == "static")
+    {
+        // 호스트는 기본 경로만, 라우터 j는 다른 라우터의 /16을 하류 또는 상류 홉으로 보냄
+        Ipv4StaticRoutingHelper staticRouting;
+        NodeContainer hosts(topology.senders, NodeContainer(topology.receiver), crossReceivers);
+        for (uint32_t i = 0; i < hosts.GetN(); ++i)
+        {
+            staticRouting.GetStaticRouting(hosts.Get(i)->GetObject<Ipv4>())->SetDefaultRoute(hostGateways[i], 1);
+        }
+        for (uint32_t j = 0; j <= nHops; ++j)
+        {
+            Ptr<Ipv4StaticRouting> routing = staticRouting.GetStaticRouting(routers.Get(j)->GetObject<Ipv4>());
+            for (uint32_t m = 0; m <= nHops; ++m)
+            {
+                Ipv4Address network((10u << 24) | (m << 16));
+                if (m > j)
+                {
+                    routing->AddNetworkRouteTo(network, Ipv4Mask("255.255.0.0"), hopInterfaces[j].GetAddress(1),
+                                               hopInterfaces[j].Get(0).second);
+                }
+                else if (m < j)
+                {
+                    routing->AddNetworkRouteTo(network, Ipv4Mask("255.255.0.0"), hopInterfaces[j - 1].GetAddress(0),
+                                               hopInterfaces[j - 1].Get(1).second);
+                }
+            }
+        }
+    }
+
+    return topology;
+}
+
+int main(int argc, char *argv[])
+{
+    ScenarioConfig config;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("transport", "Congestion control: TcpDo, TcpDoV1, TcpVegas, TcpBbr, TcpCubic, ...", config.transport);
+    cmd.AddValue("topology", "Topology: p2p, dumbbell, fattree or parkinglot", config.topology);
+    cmd.AddValue("nSenders", "Number of senders in the dumbbell, long flows in the parking lot", config.nSenders);
+    cmd.AddValue("hops", "Router hops of the parking lot", config.hops);
+    cmd.AddValue("hopRate", "Parking lot hop rate, or comma separated rates per hop", config.hopRate);
+    cmd.AddValue("hopDelay", "Parking lot hop delay in ms, or comma separated delays per hop", config.hopDelay);
+    cmd.AddValue("crossFlows", "Cross-traffic senders entering and leaving at every parking lot hop",
+                 config.crossFlows);
+    cmd.AddValue("fatTreeK", "Switch ports of the fat-tree (even, k^3/4 hosts)", config.fatTreeK);
+    cmd.AddValue("routing", "Dumbbell, fat-tree and parking lot routing: static, global or nix", config.routing);
+    cmd.AddValue("workload", "Workload: onoff (one OnOff flow per sender) or incast", config.workload);
+    cmd.AddValue("fanIn", "Incast workers answering each query, 0 for all senders", config.incast.fanIn);
+    cmd.AddValue("requestSize", "Incast request size per worker in bytes", config.incast.requestSize);
+    cmd.AddValue("responseSize", "Incast response size per worker in bytes", config.incast.responseSize);
+    cmd.AddValue("queries", "Incast queries issued one after another", config.incast.queries);
+    cmd.AddValue("queryGap", "Time from an incast query's completion to the next one", config.incast.gap);
+    cmd.AddValue("aqm", "Bottleneck queue disc: FqCoDel, CoDel, Pie, Red, ..., none or default", config.aqm);
+    cmd.AddValue("ecn", "ECN: Off, Classic or Dctcp (TcpDo EcnMode; others use classic ECN)", config.ecn);
+    cmd.AddValue("ceThreshold", "Sojourn time above which the AQM marks CE, 0 for its default",
+                 config.ceThreshold);
+    cmd.AddValue("dataRate", "Access link data rate (fat-tree: host links)", config.dataRate);
+    cmd.AddValue("bottleneckRate", "Router to receiver data rate (dumbbell; fat-tree: switch links)",
+                 config.bottleneckRate);
+    cmd.AddValue("delayModel", "Link delay distribution: constant, uniform or normal", config.delayModel);
+    cmd.AddValue("delay", "Constant link delay in ms", config.delay);
+    cmd.AddValue("delayMin", "Uniform link delay lower bound in ms", config.delayMin);
+    cmd.AddValue("delayMax", "Uniform link delay upper bound in ms", config.delayMax);
+    cmd.AddValue("delayMean", "Normal link delay mean in ms", config.delayMean);
+    cmd.AddValue("delayVariance", "Normal link delay variance in ms^2", config.delayVariance);
+    cmd.AddValue("bottleneckDelay", "Bottleneck delay in ms, negative to draw from the delay model", config.bottleneckDelay);
+    cmd.AddValue("lossRate", "Packet error rate at the receiver", config.lossRate);
+    cmd.AddValue("appRate", "OnOff data rate per sender", config.appRate);
+    cmd.AddValue("packetSize", "OnOff packet size in bytes", config.packetSize);
+    cmd.AddValue("onTime", "OnOff on time random variable", config.onTime);
+    cmd.AddValue("offTime", "OnOff off time random variable", config.offTime);
+    cmd.AddValue("simulationTime", "Simulation time in seconds", config.simulationTime);
+    cmd.AddValue("throughputBin", "Width of a per-flow goodput bin, e.g. 1ms or 100ms", config.throughputBin);
+    cmd.AddValue("rawTrace", "Write every sample to trace-<prefix>.bin besides the summary", config.rawTrace);
+    cmd.AddValue("flightRecorder", "Only write raw samples around cwnd drops, RTOs and goodput drops",
+                 config.flightRecorder);
+    cmd.AddValue("flightHistory", "Samples kept in memory before a trigger", config.flight.history);
+    cmd.AddValue("flightAfter", "Samples written after a trigger", config.flight.after);
+    cmd.AddValue("cwndDropTrigger", "Relative cwnd reduction that triggers a dump, 0 disables",
+                 config.flight.cwndDrop);
+    cmd.AddValue("goodputDropTrigger", "Relative goodput drop between bins that triggers a dump, 0 disables",
+                 config.flight.goodputDrop);
+    cmd.AddValue("rtoTrigger", "Trigger a dump on every RTO", config.flight.rto);
+    cmd.AddValue("audit", "Write every TcpDo window decision to audit-<prefix>.bin", config.audit);
+    cmd.AddValue("pacing", "Pace TCP segments instead of sending them back to back", config.pacing);
+    cmd.AddValue("pacingGain", "Pacing rate as a multiple of cwnd over the smoothed RTT", config.pacingGain);
+    cmd.AddValue("seed", "Random number generator seed", config.seed);
+    cmd.AddValue("prefix", "Output file prefix (default: <transport>-<topology>)", config.prefix);
+    cmd.Parse(argc, argv);
+
+    LogComponentEnable("TcpScenario", LOG_LEVEL_INFO);
+    auto setupStart = std::chrono::steady_clock::now();
+
+    RngSeedManager::SetSeed(config.seed);
+
+    std::string transport = config.transport;
+    if (transport.find("ns3::") != 0)
+    {
+        transport = "ns3::" + transport;
+    }
+    TypeId tcpTypeId;
+    NS_ABORT_MSG_UNLESS(TypeId::LookupByNameFailSafe(transport, &tcpTypeId), "Unknown transport: " << transport);
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", TypeIdValue(tcpTypeId));
+
+    // 페이싱 속도는 소켓이 ACK마다 cwnd/srtt에 비율(%)을 곱해 계산 (TcpDo 포함)
+    Config::SetDefault("ns3::TcpSocketState::EnablePacing", BooleanValue(config.pacing));
+    Config::SetDefault("ns3::TcpSocketState::PaceInitialWindow", BooleanValue(config.pacing));
+    if (config.pacing)
+    {
+        // 비율은 정수 %이므로 0으로 반올림되는 이득은 속도 0이 됨
+        NS_ABORT_MSG_IF(config.pacingGain < 0.01, "--pacingGain must be at least 0.01");
+        UintegerValue ratio(static_cast<uint32_t>(config.pacingGain * 100 + 0.5));
+        Config::SetDefault("ns3::TcpSocketState::PacingSsRatio", ratio);
+        Config::SetDefault("ns3::TcpSocketState::PacingCaRatio", ratio);
+    }
+
+    // ECN: 수신 소켓도 협상해야 하므로 모든 소켓에서 켜고, 병목 AQM은 드롭 대신 표시
+    if (config.ecn != "Off")
+    {
+        NS_ABORT_MSG_UNLESS(config.ecn == "Classic" || config.ecn == "Dctcp", "Unknown ECN mode: " << config.ecn);
+        Config::SetDefault("ns3::TcpSocketBase::UseEcn", StringValue("On"));
+        Config::SetDefaultFailSafe(tcpTypeId.GetName() + "::EcnMode", StringValue(config.ecn));
+        // 장치 큐만 남는 "none"은 표시할 수 없고, "default"는 ns-3가 설치하는 FqCoDel
+        NS_ABORT_MSG_IF(config.aqm == "none", "--ecn needs a queue disc that marks, not --aqm=none");
+        std::string queueDisc =
+            config.aqm == "default" ? "ns3::FqCoDelQueueDisc" : "ns3::" + config.aqm + "QueueDisc";
+        NS_ABORT_MSG_UNLESS(Config::SetDefaultFailSafe(queueDisc + "::UseEcn", BooleanValue(true)),
+                            config.aqm << " cannot mark ECN");
+        if (!config.ceThreshold.IsZero())
+        {
+            bool set = Config::SetDefaultFailSafe(queueDisc + "::CeThreshold", TimeValue(config.ceThreshold));
+            NS_ABORT_MSG_UNLESS(set, config.aqm << " has no CeThreshold");
+        }
+    }
+
+    if (config.prefix.empty())
+    {
+        config.prefix = tcpTypeId.GetName().substr(5) + "-" + config.topology;
+        std::transform(config.prefix.begin(), config.prefix.end(), config.prefix.begin(), ::tolower);
+    }
+
+    Ptr<RandomVariableStream> delayVar = CreateDelayVariable(config);
+    delayVar->SetStream(1);
+
+    ScenarioTopology topology;
+    if (config.topology == "p2p")
+    {
+        topology = BuildPointToPoint(config, delayVar);
+    }
+    else if (config.topology == "fattree")
+    {
+        topology = BuildFatTree(config, delayVar);
+    }
+    else if (config.topology == "parkinglot")
+    {
+        topology = BuildParkingLot(config, delayVar);
+    }
+    else
+    {
+        NS_ABORT_MSG_UNLESS(config.topology == "dumbbell", "Unknown topology: " << config.topology);
+        topology = BuildDumbbell(config, delayVar);
+    }
+    NS_ABORT_MSG_UNLESS(config.workload == "onoff" || config.workload == "incast",
+                        "Unknown workload: " << config.workload);
+
+    // 패킷 손실을 유발하는 ErrorModel을 receiver의 장치에 적용 (parking lot은 마지막 홉이 아닌 접속 링크)
+    if (config.lossRate > 0)
+    {
+        Ptr<RateErrorModel> em = CreateObject<RateErrorModel>();
+        em->SetAttribute("ErrorRate", DoubleValue(config.lossRate));
+        em->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
+        topology.receiverDevice->SetAttribute("ReceiveErrorModel", PointerValue(em));
+    }
+
+    // 플로우별 RTT/goodput 분포는 항상 메모리에서 집계하고,
+    // 원시 샘플은 요청 시에만 바이너리 트레이스로 기록 (CSV는 tcp-trace-convert로 변환)
+    Ptr<FlowSummary> flowSummary = Create<FlowSummary>();
+    Ptr<TraceSink> traceSink;
+    if (config.rawTrace || config.flightRecorder)
+    {
+        traceSink = Create<TraceSink>("trace-" + config.prefix + ".bin");
+        if (config.flightRecorder)
+        {
+            traceSink->EnableFlightRecorder(config.flight);
+        }
+    }
+    Ptr<AuditLog> auditLog;
+    if (config.audit)
+    {
+        auditLog = Create<AuditLog>("audit-" + config.prefix + ".bin");
+    }
+    // 병목이 여러 개인 parking lot은 모든 홉에 AQM을 설치하고 각 큐를 홉 순서대로 추적
+    NetDeviceContainer queueDevices = topology.hops.GetN() > 0 ? topology.hops
+                                                               : NetDeviceContainer(topology.bottleneck.Get(0));
+    Ptr<FlowTracer> flowTracer = Create<FlowTracer>(traceSink, flowSummary, auditLog);
+    for (uint32_t i = 0; i < queueDevices.GetN(); ++i)
+    {
+        InstallBottleneckQueueDisc(config, queueDevices.Get(i));
+        flowTracer->TrackQueue(queueDevices.Get(i), topology.senders.GetN() + i);
+    }
+    Ptr<ThroughputMonitor> throughputMonitor =
+        Create<ThroughputMonitor>(traceSink, config.throughputBin, flowSummary);
+
+    // incast: receiver가 aggregator로서 sender들에게 질의하고, 연결은 1초에 한꺼번에 맺음
+    Ptr<IncastWorkload> incast;
+    if (config.workload == "incast")
+    {
+        incast = Create<IncastWorkload>(topology.receiver, topology.receiverAddress, topology.senders,
+                                        config.incast, flowTracer);
+        incast->Start(Seconds(1.0));
+    }
+
+    // sender마다 별도의 포트와 PacketSink를 사용하여 플로우별 처리량을 구분
+    Ptr<UniformRandomVariable> startVar = CreateObject<UniformRandomVariable>();
+    startVar->SetAttribute("Min", DoubleValue(0.0));
+    startVar->SetAttribute("Max", DoubleValue(1.0));
+    startVar->SetStream(2);
+
+    NS_ABORT_MSG_IF(!incast && topology.senders.GetN() > MAX_SINK_PORTS,
+                    "At most " << MAX_SINK_PORTS << " senders fit the sink ports " << SINK_BASE_PORT << "-65535, not "
+                               << topology.senders.GetN());
+    for (uint32_t i = 0; !incast && i < topology.senders.GetN(); ++i)
+    {
+        uint16_t port = SINK_BASE_PORT + i;
+        bool ownSink = topology.sinks.GetN() > 0;
+        Ptr<Node> sinkNode = ownSink ? topology.sinks.Get(i) : topology.receiver;
+        Address sinkAddress(InetSocketAddress(ownSink ? topology.sinkAddresses[i] : topology.receiverAddress, port));
+
+        PacketSinkHelper packetSinkHelper("ns3::TcpSocketFactory", sinkAddress);
+        ApplicationContainer sinkApp = packetSinkHelper.Install(sinkNode);
+        sinkApp.Start(Seconds(0.0));
+        sinkApp.Stop(Seconds(config.simulationTime));
+        throughputMonitor->Track(DynamicCast<PacketSink>(sinkApp.Get(0)), i);
+
+        OnOffHelper onOffHelper("ns3::TcpSocketFactory", sinkAddress);
+        onOffHelper.SetAttribute("DataRate", StringValue(config.appRate));
+        onOffHelper.SetAttribute("PacketSize", UintegerValue(config.packetSize));
+        onOffHelper.SetAttribute("OnTime", StringValue(config.onTime));
+        onOffHelper.SetAttribute("OffTime", StringValue(config.offTime));
+
+        // sender 0은 1초에, 나머지는 1~2초 사이에 랜덤하게 시작
+        ApplicationContainer clientApp = onOffHelper.Install(topology.senders.Get(i));
+        clientApp.Start(Seconds(i == 0 ? 1.0 : 1.0 + startVar->GetValue()));
+        clientApp.Stop(Seconds(config.simulationTime));
+
+        // 모든 플로우의 소켓 트레이스를 플로우 번호와 함께 같은 트레이스 파일에 기록
+        flowTracer->Track(clientApp.Get(0), i);
+    }
+
+    auto runStart = std::chrono::steady_clock::now();
+    NS_LOG_INFO("Set up " << topology.senders.GetN() << " sender(s) in "
+                << std::chrono::duration<double>(runStart - setupStart).count() << " s (routing: "
+                << (config.topology == "p2p" ? "none" : config.routing) << "), peak RSS "
+                << GetPeakRssMb() << " MB");
+
+    Simulator::Stop(Seconds(config.simulationTime));
+    Simulator::Run();
+
+    NS_LOG_INFO("Simulated " << config.simulationTime << " s in "
+                << std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count()
+                << " s, peak RSS " << GetPeakRssMb() << " MB");
+
+    // 플로우별 평균 처리량 및 Jain 공정성 지수 (스윕 집계를 위해 파일로도 기록)
+    throughputMonitor->Finish(Seconds(config.simulationTime));
+    throughputMonitor->WriteFlowStats("flows-" + config.prefix + ".csv");
+    flowSummary->Write("summary-" + config.prefix + ".csv");
+    flowTracer->WriteQueueStats("queue-" + config.prefix + ".csv", Seconds(config.simulationTime));
+
+    uint32_t nFlows = throughputMonitor->GetFlowStats().size();
+    if (nFlows > 0)
+    {
+        double aggregate = throughputMonitor->GetAggregateMbps();
+        NS_LOG_INFO(tcpTypeId.GetName() << " " << config.topology << " with " << nFlows
+                    << " flow(s): aggregate " << aggregate << " Mbps, mean " << aggregate / nFlows
+                    << " Mbps, Jain index " << throughputMonitor->GetJainIndex());
+    }
+    if (incast)
+    {
+        // QCT 꼬리는 주로 RTO가 결정하므로 타임아웃이 난 질의 수도 함께 출력
+        incast->WriteQueryStats("queries-" + config.prefix + ".csv");
+        const LogLinearHistogram& qct = incast->GetQct();
+        NS_LOG_INFO(tcpTypeId.GetName() << " " << config.topology << " incast: " << incast->GetCompletedCount()
+                    << " of " << incast->GetIssuedCount() << " queries completed, QCT p50 "
+                    << qct.GetPercentile(0.5) * 1e3 << " ms, p95 " << qct.GetPercentile(0.95) * 1e3
+                    << " ms, p99 " << qct.GetPercentile(0.99) * 1e3 << " ms, max " << qct.GetMax() * 1e3 << " ms, "
+                    << incast->GetTimeoutCount() << " RTOs in " << incast->GetQueriesWithTimeout() << " queries");
+    }
+    if (!topology.senderHops.empty())
+    {
+        // 경로 길이별 처리량: 긴 플로우(큰 baseRtt)가 한 홉 교차 트래픽보다 얼마나 불리한지 비교
+        std::ofstream paths("paths-" + config.prefix + ".csv", std::ios::out | std::ios::trunc);
+        paths << "flow,first_hop,hops,throughput_mbps\n";
+        std::vector<double> longRates;
+        std::vector<std::vector<double>> crossRates(topology.hops.GetN());
+        for (const ThroughputMonitor::FlowStats& stats : throughputMonitor->GetFlowStats())
+        {
+            uint32_t firstHop = topology.senderFirstHop[stats.flowId];
+            uint32_t hops = topology.senderHops[stats.flowId];
+            paths << stats.flowId << "," << firstHop << "," << hops << "," << stats.goodputMbps << "\n";
+            if (stats.flowId < config.nSenders)
+            {
+                longRates.push_back(stats.goodputMbps);
+            }
+            else
+            {
+                crossRates[firstHop].push_back(stats.goodputMbps);
+            }
+        }
+
+        double longMean = longRates.empty() ? 0.0 : std::accumulate(longRates.begin(), longRates.end(), 0.0) /
+                                                        longRates.size();
+        NS_LOG_INFO(longRates.size() << " long flow(s) over " << topology.hops.GetN() << " hops: mean " << longMean
+                    << " Mbps, Jain index " << ThroughputMonitor::GetJainIndex(longRates));
+        for (uint32_t hop = 0; hop < crossRates.size(); ++hop)
+        {
+            const std::vector<double>& rates = crossRates[hop];
+            double crossMean = rates.empty() ? 0.0 : std::accumulate(rates.begin(), rates.end(), 0.0) / rates.size();
+            NS_LOG_INFO("Hop " << hop << ": " << rates.size() << " cross flow(s), mean " << crossMean
+                        << " Mbps, long over cross " << (crossMean > 0 ? longMean / crossMean : 0.0));
+        }
+    }
+    for (const FlowTracer::QueueStats& queue : flowTracer->GetQueueStats(Seconds(config.simulationTime)))
+    {
+        uint32_t hop = queue.linkId - topology.senders.GetN();
+        NS_LOG_INFO((topology.hops.GetN() > 0 ? "Hop " + std::to_string(hop) + " queue (" : "Bottleneck queue (")
+                    << config.aqm << "): mean " << queue.meanPackets << " packets, max "
+                    << queue.maxPackets << " packets, mean sojourn " << queue.meanSojourn * 1e3 << " ms, "
+                    << queue.drops << " drops, " << queue.marks << " ECN marks" << (config.pacing ? " (paced)" : ""));
+    }
+
+    Simulator::Destroy();
+
+    NS_LOG_INFO("Traced " << flowTracer->GetAttachedCount() << " flow(s)");
+    if (traceSink)
+    {
+        NS_LOG_INFO("Wrote " << traceSink->GetRecordCount() << " of " << traceSink->GetSampleCount()
+                    << " raw trace samples (" << traceSink->GetTriggerCount() << " flight recorder triggers)");
+        traceSink->Close();
+    }
+    if (auditLog)
+    {
+        // 실패한 쓰기는 writer 스레드가 끝난 뒤에야 모두 집계됨
+        auditLog->Close();
+        NS_LOG_INFO("Wrote " << auditLog->GetRecordCount() - auditLog->GetFailedCount() << " of "
+                    << auditLog->GetRecordCount() << " audit records (" << auditLog->GetStallCount()
+                    << " stalls on a full buffer, " << auditLog->GetFailedCount() << " failed writes)");
+    }
+
+    return 0;
+}
@@ -0,0 +1,330 @@
+#!/usr/bin/env python3
+"""Parallel parameter sweep over the tcp-scenario program.
+
+Expands a grid over congestion control, run number (RngRun), loss rate,
+link delay, pacing, bottleneck AQM, ECN and TcpDo/TcpDoV1 CongestionThreshold, runs every point as its own
+tcp-scenario process with at most --jobs running at once, and merges the
+per-run RTT and goodput percentiles, bottleneck queue statistics and
+per-flow outputs into one summary table.  Runs only write their in-memory percentile summaries unless
+--raw-trace is given, which also keeps every raw sample (and the mean cwnd).
+
+Each run executes in <out>/<run id>/ so its output files never collide.
+Failed or timed-out runs are retried up to --retries times and then
+reported in the summary; they never stop the rest of the sweep.
+
+Example (from the ns-3 root, after building):
+
+    ./scratch/tcp-do/tcp-sweep.py --runs 1-10 --loss-rates 0,0.001,0.01 \\
+        --delays 1,20 --thresholds 0.0005,0.001,0.002 --jobs 64 \\
+        -- --topology=dumbbell --nSenders=10 --simulationTime=20
+
+Pacing on and off side by side (queue, drops and p99 RTT per run):
+
+    ./scratch/tcp-do/tcp-sweep.py --transports TcpDo --runs 1-10 --pacing off,on
+
+Delay and throughput of TcpDo, BBR and Cubic under AQM:
+
+    ./scratch/tcp-do/tcp-sweep.py --transports TcpDo,TcpBbr,TcpCubic --runs 1-5 \\
+        --aqms none,FqCoDel,CoDel,Pie,Red
+
+ECN marking instead of drops (add --ceThreshold=1ms after -- for Dctcp):
+
+    ./scratch/tcp-do/tcp-sweep.py --transports TcpDo --aqms FqCoDel --ecn Off,Classic,Dctcp
+"""
+
+import argparse
+import concurrent.futures
+import csv
+import glob
+import itertools
+import os
+import struct
+import subprocess
+import sys
+import time
+
+ALGORITHMS = ["TcpDo", "TcpDoV1", "TcpVegas", "TcpBbr", "TcpCubic"]
+
+# Congestion controls with a CongestionThreshold attribute
+THRESHOLD_ALGORITHMS = ("TcpDo", "TcpDoV1")
+
+# Binary trace layout, see trace-record.h
+TRACE_HEADER = struct.Struct("<8sII")
+TRACE_RECORD = struct.Struct("<qIHHd")
+TRACE_RTT = 0
+TRACE_THROUGHPUT = 1
+TRACE_CWND = 2
+
+SUMMARY_FIELDS = [
+    "run_id", "transport", "run", "loss_rate", "delay_ms", "pacing", "aqm", "ecn", "threshold",
+    "status", "attempts", "wall_s",
+    "rtt_samples", "rtt_mean_ms", "rtt_p50_ms", "rtt_p95_ms", "rtt_p99_ms", "cwnd_mean_bytes",
+    "max_queue_mean_packets", "queue_max_packets", "queue_drops", "queue_sojourn_ms", "queue_marks",
+    "throughput_mean_mbps", "flows", "aggregate_mbps", "jain_index",
+]
+
+
+def parse_list(text, cast):
+    return [cast(item) for item in text.split(",") if item]
+
+
+def parse_switch(text):
+    """Parse 'on'/'off' (or 1/0, true/false) into a bool."""
+    value = text.strip().lower()
+    if value in ("on", "1", "true", "yes"):
+        return True
+    if value in ("off", "0", "false", "no"):
+        return False
+    raise argparse.ArgumentTypeError("expected on or off, got %r" % text)
+
+
+def parse_runs(text):
+    """Parse '1-5,8' into [1, 2, 3, 4, 5, 8]."""
+    runs = []
+    for item in text.split(","):
+        if "-" in item:
+            first, last = item.split("-", 1)
+            runs.extend(range(int(first), int(last) + 1))
+        elif item:
+            runs.append(int(item))
+    return runs
+
+
+def find_binary():
+    """Locate the tcp-scenario executable in a standard ns-3 build tree."""
+    here = os.path.dirname(os.path.abspath(__file__))
+    ns3_root = os.path.dirname(os.path.dirname(here))
+    pattern = os.path.join(ns3_root, "build", "scratch", "tcp-do", "*tcp-scenario*")
+    candidates = [path for path in glob.glob(pattern) if os.access(path, os.X_OK)]
+    if not candidates:
+        sys.exit("tcp-scenario executable not found under %s; build it or pass --binary"
+                 % os.path.dirname(pattern))
+    return sorted(candidates)[0]
+
+
+def expand_grid(args):
+    """Yield one parameter dict per run; the threshold only varies for the TcpDo variants."""
+    for transport in args.transports:
+        thresholds = args.thresholds if transport in THRESHOLD_ALGORITHMS and args.thresholds else [None]
+        for run, loss, delay, pacing, aqm, ecn, threshold in itertools.product(
+                args.runs, args.loss_rates, args.delays, args.pacing, args.aqms, args.ecn, thresholds):
+            point = {
+                "transport": transport,
+                "run": run,
+                "loss_rate": loss,
+                "delay_ms": delay,
+                "pacing": pacing,
+                "aqm": aqm,
+                "ecn": ecn,
+                "threshold": threshold,
+            }
+            point["run_id"] = run_id(point)
+            yield point
+
+
+def run_id(point):
+    name = "%s-run%d-loss%g-delay%g" % (
+        point["transport"].lower(), point["run"], point["loss_rate"], point["delay_ms"])
+    if point["pacing"]:
+        name += "-paced"
+    if point["aqm"] != "default":
+        name += "-%s" % point["aqm"].lower()
+    if point["ecn"] != "Off":
+        name += "-ecn%s" % point["ecn"].lower()
+    if point["threshold"] is not None:
+        name += "-thr%g" % point["threshold"]
+    return name
+
+
+def build_command(binary, point, args):
+    command = [
+        binary,
+        "--transport=%s" % point["transport"],
+        "--RngRun=%d" % point["run"],
+        "--lossRate=%g" % point["loss_rate"],
+        "--delayModel=constant",
+        "--delay=%g" % point["delay_ms"],
+        "--prefix=%s" % point["run_id"],
+        "--rawTrace=%s" % ("true" if args.raw_trace else "false"),
+        "--pacing=%s" % ("true" if point["pacing"] else "false"),
+        "--aqm=%s" % point["aqm"],
+        "--ecn=%s" % point["ecn"],
+    ]
+    if point["threshold"] is not None:
+        command.append("--ns3::%s::CongestionThreshold=%g" % (point["transport"], point["threshold"]))
+    return command + args.extra
+
+
+def execute(binary, point, args):
+    """Run one grid point with retries; never raises."""
+    workdir = os.path.join(args.out, point["run_id"])
+    os.makedirs(workdir, exist_ok=True)
+    command = build_command(binary, point, args)
+
+    status = "failed"
+    started = time.monotonic()
+    attempts = 0
+    for attempts in range(1, args.retries + 2):
+        with open(os.path.join(workdir, "run.log"), "w") as log:
+            log.write(" ".join(command) + "\n")
+            log.flush()
+            try:
+                proc = subprocess.run(command, cwd=workdir, stdout=log, stderr=subprocess.STDOUT,
+                                      timeout=args.timeout)
+                status = "ok" if proc.returncode == 0 else "exit %d" % proc.returncode
+            except subprocess.TimeoutExpired:
+                status = "timeout"
+            except OSError as error:
+                status = "error: %s" % error
+        if status == "ok":
+            break
+
+    result = dict(point)
+    result.update(status=status, attempts=attempts, wall_s=round(time.monotonic() - started, 3))
+    if status == "ok":
+        try:
+            result.update(summarize(workdir, point["run_id"]))
+        except (OSError, KeyError, ValueError, struct.error) as error:
+            result["status"] = "bad output: %s" % error
+    return result
+
+
+def read_trace(path):
+    """Return {kind: [(time_s, flow, value), ...]} from a binary trace file."""
+    samples = {}
+    if not os.path.exists(path):
+        return samples
+    with open(path, "rb") as handle:
+        magic, version, record_size = TRACE_HEADER.unpack(handle.read(TRACE_HEADER.size))
+        if magic != b"TCPTRACE" or version != 1 or record_size != TRACE_RECORD.size:
+            raise ValueError("%s is not a trace file of the current format" % path)
+        data = handle.read()
+    usable = len(data) - len(data) % TRACE_RECORD.size
+    for time_ns, flow, kind, _, value in TRACE_RECORD.iter_unpack(data[:usable]):
+        samples.setdefault(kind, []).append((time_ns * 1e-9, flow, value))
+    return samples
+
+
+def read_summary_row(path, flow):
+    """Return the row of one flow (or "all") of a summary CSV as a dict of floats."""
+    with open(path) as handle:
+        for row in csv.DictReader(handle):
+            if row["flow"] == flow:
+                return {key: float(value) for key, value in row.items() if key != "flow"}
+    raise ValueError("%s has no row for flow %s" % (path, flow))
+
+
+def read_column(path, column):
+    """Read one numeric column from a CSV file, skipping a header if present."""
+    values = []
+    if not os.path.exists(path):
+        return values
+    with open(path) as handle:
+        for row in csv.reader(handle):
+            try:
+                values.append(float(row[column]))
+            except (ValueError, IndexError):
+                continue
+    return values
+
+
+def summarize(workdir, prefix):
+    merged = read_summary_row(os.path.join(workdir, "summary-%s.csv" % prefix), "all")
+    trace = read_trace(os.path.join(workdir, "trace-%s.bin" % prefix))
+    cwnds = [value for _, _, value in trace.get(TRACE_CWND, [])]
+    flows = read_column(os.path.join(workdir, "flows-%s.csv" % prefix), 1)
+    queue = os.path.join(workdir, "queue-%s.csv" % prefix)
+    queue_means = read_column(queue, 1)
+    queue_maxima = read_column(queue, 2)
+    queue_drops = read_column(queue, 3)
+    queue_sojourns = read_column(queue, 4)
+    queue_marks = read_column(queue, 5)
+
+    def rtt(key):
+        return merged[key] if merged["rtt_samples"] else float("nan")
+
+    aggregate = sum(flows)
+    squares = sum(value * value for value in flows)
+    return {
+        "rtt_samples": int(merged["rtt_samples"]),
+        "rtt_mean_ms": rtt("rtt_mean_ms"),
+        "rtt_p50_ms": rtt("rtt_p50_ms"),
+        "rtt_p95_ms": rtt("rtt_p95_ms"),
+        "rtt_p99_ms": rtt("rtt_p99_ms"),
+        "cwnd_mean_bytes": sum(cwnds) / len(cwnds) if cwnds else float("nan"),
+        # Mean occupancy of the most loaded queue; with several tracked queues
+        # (one per parking-lot hop) their sum is not the occupancy of any queue
+        "max_queue_mean_packets": max(queue_means) if queue_means else float("nan"),
+        "queue_max_packets": int(max(queue_maxima)) if queue_maxima else 0,
+        "queue_drops": int(sum(queue_drops)),
+        "queue_sojourn_ms": max(queue_sojourns) if queue_sojourns else float("nan"),
+        "queue_marks": int(sum(queue_marks)),
+        "throughput_mean_mbps": merged["goodput_mean_mbps"] if merged["goodput_bins"] else float("nan"),
+        "flows": len(flows),
+        "aggregate_mbps": aggregate,
+        "jain_index": aggregate * aggregate / (len(flows) * squares) if squares > 0 else float("nan"),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--binary", help="tcp-scenario executable (default: search build/)")
+    parser.add_argument("--transports", type=lambda text: parse_list(text, str),
+                        default=ALGORITHMS, help="comma separated congestion controls")
+    parser.add_argument("--runs", type=parse_runs, default=[1], help="RngRun values, e.g. 1-10")
+    parser.add_argument("--loss-rates", type=lambda text: parse_list(text, float), default=[0.0])
+    parser.add_argument("--delays", type=lambda text: parse_list(text, float), default=[1.0],
+                        help="constant link delays in ms")
+    parser.add_argument("--pacing", type=lambda text: parse_list(text, parse_switch), default=[False],
+                        help="comma separated on/off values, e.g. off,on")
+    parser.add_argument("--aqms", type=lambda text: parse_list(text, str), default=["default"],
+                        help="comma separated bottleneck queue discs, e.g. none,FqCoDel,Red")
+    parser.add_argument("--ecn", type=lambda text: parse_list(text, str), default=["Off"],
+                        help="comma separated ECN modes: Off, Classic, Dctcp")
+    parser.add_argument("--thresholds", type=lambda text: parse_list(text, float), default=[],
+                        help="TcpDo and TcpDoV1 CongestionThreshold values")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="concurrent runs")
+    parser.add_argument("--timeout", type=float, default=None, help="per-attempt timeout in s")
+    parser.add_argument("--retries", type=int, default=1, help="retries per failed run")
+    parser.add_argument("--out", default="sweep-results", help="output directory")
+    parser.add_argument("--raw-trace", action="store_true",
+                        help="keep every raw sample in trace-<run id>.bin")
+    parser.add_argument("extra", nargs="*", help="arguments passed to every run (after --)")
+    args = parser.parse_args()
+
+    binary = os.path.abspath(args.binary) if args.binary else find_binary()
+    os.makedirs(args.out, exist_ok=True)
+    points = list(expand_grid(args))
+    print("%d runs, %d at a time, binary %s" % (len(points), args.jobs, binary))
+
+    results = []
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = [pool.submit(execute, binary, point, args) for point in points]
+        for done, future in enumerate(concurrent.futures.as_completed(futures), 1):
+            result = future.result()
+            results.append(result)
+            print("[%d/%d] %s: %s (%gs)" % (done, len(points), result["run_id"],
+                                            result["status"], result["wall_s"]))
+
+    order = {point["run_id"]: index for index, point in enumerate(points)}
+    results.sort(key=lambda result: order[result["run_id"]])
+    summary_path = os.path.join(args.out, "summary.csv")
+    with open(summary_path, "w", newline="") as handle:
+        writer = csv.DictWriter(handle, fieldnames=SUMMARY_FIELDS, extrasaction="ignore")
+        writer.writeheader()
+        writer.writerows(results)
+
+    failed = [result for result in results if result["status"] != "ok"]
+    print("summary written to %s" % summary_path)
+    if failed:
+        print("%d run(s) failed:" % len(failed))
+        for result in failed:
+            print("  %s: %s after %d attempt(s)" % (result["run_id"], result["status"],
+                                                   result["attempts"]))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,172 @@
+#include "throughput-monitor.h"
+
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace ns3 {
+
+ThroughputMonitor::ThroughputMonitor(Ptr<TraceSink> sink, Time binWidth, Ptr<FlowSummary> summary)
+    : m_sink(sink),
+      m_summary(summary),
+      m_binSteps(binWidth.GetTimeStep()),
+      m_bitsToMbps(8.0 / (1e6 * binWidth.GetSeconds())),
+      m_finished(false)
+{
+    NS_ABORT_MSG_UNLESS(binWidth.IsStrictlyPositive(), "Throughput bin width must be positive");
+}
+
+void ThroughputMonitor::Track(Ptr<PacketSink> sink, uint32_t flowId)
+{
+    uint32_t index = m_flows.size();
+    m_flows.push_back(Flow{0, 0, 0.0, 0.0, false});
+    m_stats.push_back(FlowStats{flowId, 0, Time(0), 0.0, 0, 0.0, 0.0, 0.0});
+
+    sink->TraceConnectWithoutContext("Rx", MakeBoundCallback(&ThroughputMonitor::HandleRx, this, index));
+}
+
+void ThroughputMonitor::HandleRx(ThroughputMonitor* monitor,
+                                 uint32_t index,
+                                 Ptr<const Packet> packet,
+                                 const Address& from)
+{
+    if (monitor->m_finished)
+    {
+        return;
+    }
+
+    Flow& flow = monitor->m_flows[index];
+    int64_t bin = Simulator::Now().GetTimeStep() / monitor->m_binSteps;
+    if (!flow.started)
+    {
+        flow.started = true;
+        flow.currentBin = bin;
+        monitor->m_stats[index].firstRx = TimeStep(bin * monitor->m_binSteps);
+    }
+    else if (bin != flow.currentBin)
+    {
+        monitor->CloseBins(index, bin);
+    }
+
+    flow.binBytes += packet->GetSize();
+    monitor->m_stats[index].rxBytes += packet->GetSize();
+}
+
+void ThroughputMonitor::CloseBins(uint32_t index, int64_t untilBin)
+{
+    Flow& flow = m_flows[index];
+    WriteBin(index, flow.currentBin, flow.binBytes);
+
+    // 패킷이 없던 구간은 0으로 기록
+    for (int64_t bin = flow.currentBin + 1; bin < untilBin; ++bin)
+    {
+        WriteBin(index, bin, 0);
+    }
+
+    flow.currentBin = untilBin;
+    flow.binBytes = 0;
+}
+
+void ThroughputMonitor::WriteBin(uint32_t index, int64_t bin, uint64_t bytes)
+{
+    Flow& flow = m_flows[index];
+    FlowStats& stats = m_stats[index];
+
+    double rate = bytes * m_bitsToMbps;
+    if (m_sink)
+    {
+        m_sink->Write(TimeStep((bin + 1) * m_binSteps), stats.flowId, TRACE_THROUGHPUT, rate);
+    }
+    if (m_summary)
+    {
+        m_summary->RecordGoodput(stats.flowId, rate);
+    }
+
+    flow.binSum += rate;
+    flow.binSumSquares += rate * rate;
+    stats.binMaxMbps = std::max(stats.binMaxMbps, rate);
+    ++stats.bins;
+}
+
+void ThroughputMonitor::Finish(Time stop)
+{
+    if (m_finished)
+    {
+        return;
+    }
+    m_finished = true;
+
+    // 마지막(부분) 구간까지 닫음
+    int64_t lastBin = (stop.GetTimeStep() + m_binSteps - 1) / m_binSteps;
+    for (uint32_t i = 0; i < m_flows.size(); ++i)
+    {
+        Flow& flow = m_flows[i];
+        FlowStats& stats = m_stats[i];
+        if (!flow.started)
+        {
+            continue;
+        }
+
+        CloseBins(i, std::max(lastBin, flow.currentBin + 1));
+
+        double activeTime = (stop - stats.firstRx).GetSeconds();
+        stats.goodputMbps = activeTime > 0 ? stats.rxBytes * 8 / (1e6 * activeTime) : 0.0;
+        stats.binMeanMbps = flow.binSum / stats.bins;
+        double variance = flow.binSumSquares / stats.bins - stats.binMeanMbps * stats.binMeanMbps;
+        stats.binStdDevMbps = std::sqrt(std::max(0.0, variance));
+    }
+}
+
+const std::vector<ThroughputMonitor::FlowStats>& ThroughputMonitor::GetFlowStats() const
+{
+    return m_stats;
+}
+
+double ThroughputMonitor::GetAggregateMbps() const
+{
+    double sum = 0.0;
+    for (const FlowStats& stats : m_stats)
+    {
+        sum += stats.goodputMbps;
+    }
+    return sum;
+}
+
+double ThroughputMonitor::GetJainIndex() const
+{
+    std::vector<double> rates;
+    rates.reserve(m_stats.size());
+    for (const FlowStats& stats : m_stats)
+    {
+        rates.push_back(stats.goodputMbps);
+    }
+    return GetJainIndex(rates);
+}
+
+double ThroughputMonitor::GetJainIndex(const std::vector<double>& rates)
+{
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    for (double rate : rates)
+    {
+        sum += rate;
+        sumSquares += rate * rate;
+    }
+    return sumSquares > 0 ? (sum * sum) / (rates.size() * sumSquares) : 0.0;
+}
+
+void ThroughputMonitor::WriteFlowStats(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    file << "flow,throughput_mbps,rx_bytes,bins,bin_mean_mbps,bin_stddev_mbps,bin_max_mbps\n";
+    for (const FlowStats& stats : m_stats)
+    {
+        file << stats.flowId << "," << stats.goodputMbps << "," << stats.rxBytes << "," << stats.bins << ","
+             << stats.binMeanMbps << "," << stats.binStdDevMbps << "," << stats.binMaxMbps << "\n";
+    }
+}
+
+} // namespace ns3
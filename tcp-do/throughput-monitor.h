@@ -0,0 +1,128 @@
+#ifndef THROUGHPUT_MONITOR_H
+#define THROUGHPUT_MONITOR_H
+
+#include "flow-summary.h"
+#include "trace-sink.h"
+
+#include "ns3/address.h"
+#include "ns3/callback.h"
+#include "ns3/packet-sink.h"
+#include "ns3/packet.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Per-flow goodput time series built from PacketSink Rx traces.
+ *
+ * Every received packet is added to the current bin of its flow; when a
+ * packet falls into a later bin, the finished bin (and any empty bins in
+ * between) is written to the TraceSink as a TRACE_THROUGHPUT record in Mbps
+ * stamped with the bin's end time, and counted in the optional FlowSummary.  Bins are closed lazily on reception and
+ * by Finish(), so no scheduler event is needed per bin and the bin width can
+ * go down to a millisecond or less.
+ *
+ * Finish() also closes the per-flow statistics: total bytes, goodput over
+ * the flow's active period and the mean, standard deviation and maximum of
+ * its bin rates, plus the aggregate goodput and Jain's fairness index.
+ */
+class ThroughputMonitor : public SimpleRefCount<ThroughputMonitor>
+{
+public:
+    /**
+     * Summary of one flow, valid after Finish().
+     */
+    struct FlowStats
+    {
+        uint32_t flowId;      //!< Flow id passed to Track()
+        uint64_t rxBytes;     //!< Bytes received
+        Time firstRx;         //!< Start of the first non-empty bin
+        double goodputMbps;   //!< rxBytes over [firstRx, end of run]
+        uint64_t bins;        //!< Bins written, including empty ones
+        double binMeanMbps;   //!< Mean bin rate
+        double binStdDevMbps; //!< Population standard deviation of bin rates
+        double binMaxMbps;    //!< Highest bin rate
+    };
+
+    /**
+     * \param sink destination of the goodput time series, may be null
+     * \param binWidth width of a goodput bin
+     * \param summary goodput distribution per flow, may be null
+     */
+    ThroughputMonitor(Ptr<TraceSink> sink, Time binWidth, Ptr<FlowSummary> summary = nullptr);
+
+    /**
+     * \brief Account packets received by \p sink to flow \p flowId.
+     * \param sink the receiving application
+     * \param flowId compact flow id
+     */
+    void Track(Ptr<PacketSink> sink, uint32_t flowId);
+
+    /**
+     * \brief Close every open bin up to \p stop and compute the statistics.
+     *
+     * A bin that \p stop cuts short is still written with the full bin width.
+     * Packets received afterwards are ignored.
+     *
+     * \param stop end of the measurement
+     */
+    void Finish(Time stop);
+
+    /**
+     * \return per-flow statistics in Track() order, valid after Finish()
+     */
+    const std::vector<FlowStats>& GetFlowStats() const;
+
+    /**
+     * \return the sum of per-flow goodput in Mbps
+     */
+    double GetAggregateMbps() const;
+
+    /**
+     * \return Jain's fairness index over per-flow goodput
+     */
+    double GetJainIndex() const;
+
+    /**
+     * \param rates goodput of a group of flows, any unit
+     * \return Jain's fairness index over \p rates, 0 if all are 0 or it is empty
+     */
+    static double GetJainIndex(const std::vector<double>& rates);
+
+    /**
+     * \brief Write one CSV line of statistics per flow to \p filename.
+     * \param filename output path, truncated
+     */
+    void WriteFlowStats(const std::string& filename) const;
+
+private:
+    /**
+     * Bin and statistics state of one flow.
+     */
+    struct Flow
+    {
+        int64_t currentBin;  //!< Index of the open bin
+        uint64_t binBytes;   //!< Bytes in the open bin
+        double binSum;       //!< Sum of closed bin rates
+        double binSumSquares; //!< Sum of squared closed bin rates
+        bool started;        //!< True once the first packet arrived
+    };
+
+    static void HandleRx(ThroughputMonitor* monitor, uint32_t index, Ptr<const Packet> packet, const Address& from);
+    void CloseBins(uint32_t index, int64_t untilBin);
+    void WriteBin(uint32_t index, int64_t bin, uint64_t bytes);
+
+    Ptr<TraceSink> m_sink;          //!< Time series destination
+    Ptr<FlowSummary> m_summary;     //!< Goodput distributions
+    int64_t m_binSteps;             //!< Bin width in time steps
+    double m_bitsToMbps;            //!< Converts bytes per bin to Mbps
+    std::vector<Flow> m_flows;      //!< Bin state, Track() order
+    std::vector<FlowStats> m_stats; //!< Statistics, Track() order
+    bool m_finished;                //!< Set by Finish()
+};
+
+} // namespace ns3
+
+#endif // THROUGHPUT_MONITOR_H
@@ -0,0 +1,125 @@
+#ifndef TRACE_RECORD_H
+#define TRACE_RECORD_H
+
+#include <cstdint>
+#include <cstring>
+
+namespace ns3 {
+
+/**
+ * \brief Kind of value carried by a TraceRecord.
+ */
+enum TraceKind : uint16_t
+{
+    TRACE_RTT = 0,             //!< RTT sample, seconds
+    TRACE_THROUGHPUT = 1,      //!< Goodput over an interval, Mbps
+    TRACE_CWND = 2,            //!< Congestion window, bytes
+    TRACE_SSTHRESH = 3,        //!< Slow start threshold, bytes
+    TRACE_BYTES_IN_FLIGHT = 4, //!< Bytes in flight
+    TRACE_CONG_STATE = 5,      //!< TcpSocketState::TcpCongState_t value
+    TRACE_QUEUE = 6,           //!< Packets queued at a link, flow id names the link
+    TRACE_TRIGGER = 7,         //!< Flight recorder dump, value is a FlightTrigger
+    TRACE_SOJOURN = 8,         //!< Time a packet spent in a link's queue disc, seconds
+    TRACE_DROP = 9,            //!< Packets dropped at a link so far, flow id names the link
+};
+
+/**
+ * \brief Condition that made a flight-recording TraceSink dump its history.
+ */
+enum FlightTrigger : uint8_t
+{
+    FLIGHT_TRIGGER_CWND_DROP = 1,    //!< cwnd fell by more than the configured fraction
+    FLIGHT_TRIGGER_RTO = 2,          //!< The socket entered CA_LOSS
+    FLIGHT_TRIGGER_GOODPUT_DROP = 3, //!< Goodput fell by more than the configured fraction between bins
+};
+
+/**
+ * \brief Fixed-size binary trace record written by TraceSink.
+ *
+ * Records are stored back to back after a TraceFileHeader in host byte
+ * order; the header lets readers check that the layout matches.
+ */
+struct TraceRecord
+{
+    int64_t timeNs;    //!< Simulation time, nanoseconds
+    uint32_t flowId;   //!< Compact flow identifier
+    uint16_t kind;     //!< One of TraceKind
+    uint16_t reserved; //!< Padding, always zero
+    double value;      //!< Sample value, unit depends on kind
+};
+
+static_assert(sizeof(TraceRecord) == 24, "TraceRecord layout must stay fixed");
+
+/**
+ * \brief Header at the start of every binary trace file.
+ */
+struct TraceFileHeader
+{
+    char magic[8];       //!< "TCPTRACE"
+    uint32_t version;    //!< Format version, currently 1
+    uint32_t recordSize; //!< sizeof(TraceRecord)
+};
+
+static_assert(sizeof(TraceFileHeader) == 16, "TraceFileHeader layout must stay fixed");
+
+static const char TRACE_FILE_MAGIC[8] = {'T', 'C', 'P', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t TRACE_FILE_VERSION = 1;
+
+/**
+ * \return a header describing the current format
+ */
+inline TraceFileHeader MakeTraceFileHeader()
+{
+    TraceFileHeader header;
+    std::memcpy(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_FILE_VERSION;
+    header.recordSize = sizeof(TraceRecord);
+    return header;
+}
+
+/**
+ * \param header a header read from a trace file
+ * \return true if the file was written in the current format
+ */
+inline bool IsValidTraceFileHeader(const TraceFileHeader& header)
+{
+    return std::memcmp(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic)) == 0 &&
+           header.version == TRACE_FILE_VERSION && header.recordSize == sizeof(TraceRecord);
+}
+
+/**
+ * \param kind a TraceKind value
+ * \return the lower-case name used in CSV output
+ */
+inline const char* GetTraceKindName(uint16_t kind)
+{
+    switch (kind)
+    {
+    case TRACE_RTT:
+        return "rtt";
+    case TRACE_THROUGHPUT:
+        return "throughput";
+    case TRACE_CWND:
+        return "cwnd";
+    case TRACE_SSTHRESH:
+        return "ssthresh";
+    case TRACE_BYTES_IN_FLIGHT:
+        return "bytes-in-flight";
+    case TRACE_CONG_STATE:
+        return "cong-state";
+    case TRACE_QUEUE:
+        return "queue";
+    case TRACE_TRIGGER:
+        return "trigger";
+    case TRACE_SOJOURN:
+        return "sojourn";
+    case TRACE_DROP:
+        return "drop";
+    default:
+        return "unknown";
+    }
+}
+
+} // namespace ns3
+
+#endif // TRACE_RECORD_H
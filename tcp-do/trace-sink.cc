@@ -0,0 +1,249 @@
+#include "trace-sink.h"
+
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+#include "ns3/tcp-socket-state.h"
+
+namespace ns3 {
+
+TraceSink::TraceSink(const std::string& filename, size_t batchRecords)
+    : m_file(std::fopen(filename.c_str(), "wb")),
+      m_batchRecords(batchRecords),
+      m_recordCount(0),
+      m_sampleCount(0),
+      m_flight(false),
+      m_ringHead(0),
+      m_ringCount(0),
+      m_recordUntilNs(0),
+      m_triggerCount(0),
+      m_closing(false)
+{
+    NS_ABORT_MSG_IF(m_file == nullptr, "Cannot open trace file " << filename);
+
+    // 배치 단위로 직접 쓰므로 stdio 버퍼는 사용하지 않음
+    std::setvbuf(m_file, nullptr, _IONBF, 0);
+    TraceFileHeader header = MakeTraceFileHeader();
+    std::fwrite(&header, sizeof(header), 1, m_file);
+
+    m_active.reserve(m_batchRecords);
+    m_writer = std::thread(&TraceSink::WriterLoop, this);
+}
+
+TraceSink::~TraceSink()
+{
+    Close();
+}
+
+void TraceSink::EnableFlightRecorder(const FlightRecorderSettings& settings)
+{
+    NS_ABORT_MSG_IF(m_sampleCount > 0, "The flight recorder must be enabled before the first sample");
+    NS_ABORT_MSG_UNLESS(settings.capacity > 0, "The flight recorder needs room for at least one record");
+    m_flight = true;
+    m_flightSettings = settings;
+    m_ring.resize(settings.capacity);
+    m_ringHead = 0;
+    m_ringCount = 0;
+    m_recordUntilNs = -1;
+}
+
+void TraceSink::Write(uint32_t flowId, TraceKind kind, double value)
+{
+    Write(Simulator::Now(), flowId, kind, value);
+}
+
+void TraceSink::Write(Time now, uint32_t flowId, TraceKind kind, double value)
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    TraceRecord record{now.GetNanoSeconds(), flowId, kind, 0, value};
+    ++m_sampleCount;
+    if (!m_flight)
+    {
+        Append(record);
+        return;
+    }
+
+    uint8_t trigger = CheckTrigger(record);
+    if (trigger != 0)
+    {
+        Dump(record, trigger);
+    }
+    if (record.timeNs <= m_recordUntilNs)
+    {
+        Append(record);
+        return;
+    }
+
+    // 링이 가득 차면 가장 오래된 샘플을 덮어씀
+    if (m_ringCount < m_ring.size())
+    {
+        m_ring[(m_ringHead + m_ringCount) % m_ring.size()] = record;
+        ++m_ringCount;
+    }
+    else
+    {
+        m_ring[m_ringHead] = record;
+        m_ringHead = (m_ringHead + 1) % m_ring.size();
+    }
+}
+
+void TraceSink::Append(const TraceRecord& record)
+{
+    m_active.push_back(record);
+    ++m_recordCount;
+    if (m_active.size() >= m_batchRecords)
+    {
+        Submit();
+    }
+}
+
+uint8_t TraceSink::CheckTrigger(const TraceRecord& record)
+{
+    if (record.flowId >= m_flightFlows.size())
+    {
+        m_flightFlows.resize(record.flowId + 1, FlightFlow{-1.0, -1.0, TcpSocketState::CA_OPEN});
+    }
+    FlightFlow& flow = m_flightFlows[record.flowId];
+
+    uint8_t trigger = 0;
+    switch (record.kind)
+    {
+    case TRACE_CWND:
+        if (m_flightSettings.cwndDrop > 0 && flow.cwnd > 0 &&
+            record.value < flow.cwnd * (1 - m_flightSettings.cwndDrop))
+        {
+            trigger = FLIGHT_TRIGGER_CWND_DROP;
+        }
+        flow.cwnd = record.value;
+        break;
+    case TRACE_CONG_STATE:
+        // 재전송 타이머 만료 시 CA_LOSS로 진입
+        if (m_flightSettings.rto && record.value == TcpSocketState::CA_LOSS && flow.congState != TcpSocketState::CA_LOSS)
+        {
+            trigger = FLIGHT_TRIGGER_RTO;
+        }
+        flow.congState = record.value;
+        break;
+    case TRACE_THROUGHPUT:
+        if (m_flightSettings.goodputDrop > 0 && flow.goodput > 0 &&
+            record.value < flow.goodput * (1 - m_flightSettings.goodputDrop))
+        {
+            trigger = FLIGHT_TRIGGER_GOODPUT_DROP;
+        }
+        flow.goodput = record.value;
+        break;
+    default:
+        break;
+    }
+    return trigger;
+}
+
+void TraceSink::Dump(const TraceRecord& record, uint8_t trigger)
+{
+    // 이력 길이보다 오래된 샘플은 버리고 나머지를 시간 순서대로 기록
+    int64_t fromNs = record.timeNs - m_flightSettings.history.GetNanoSeconds();
+    for (size_t i = 0; i < m_ringCount; ++i)
+    {
+        const TraceRecord& sample = m_ring[(m_ringHead + i) % m_ring.size()];
+        if (sample.timeNs >= fromNs)
+        {
+            Append(sample);
+        }
+    }
+    m_ringHead = 0;
+    m_ringCount = 0;
+
+    Append(TraceRecord{record.timeNs, record.flowId, TRACE_TRIGGER, 0, static_cast<double>(trigger)});
+    m_recordUntilNs = record.timeNs + m_flightSettings.after.GetNanoSeconds();
+    ++m_triggerCount;
+}
+
+void TraceSink::Close()
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    Submit();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closing = true;
+    }
+    m_wakeup.notify_all();
+    m_writer.join();
+
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+uint64_t TraceSink::GetRecordCount() const
+{
+    return m_recordCount;
+}
+
+uint64_t TraceSink::GetSampleCount() const
+{
+    return m_sampleCount;
+}
+
+uint64_t TraceSink::GetTriggerCount() const
+{
+    return m_triggerCount;
+}
+
+void TraceSink::Submit()
+{
+    if (m_active.empty())
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // 디스크가 따라오지 못하면 메모리를 늘리는 대신 배치가 반환될 때까지 대기
+    m_wakeup.wait(lock, [this] { return m_pending.size() < MAX_PENDING_BATCHES; });
+    m_pending.push_back(std::move(m_active));
+
+    if (!m_spare.empty())
+    {
+        m_active = std::move(m_spare.back());
+        m_spare.pop_back();
+    }
+    else
+    {
+        m_active = Batch();
+        m_active.reserve(m_batchRecords);
+    }
+    lock.unlock();
+    m_wakeup.notify_all();
+}
+
+void TraceSink::WriterLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wakeup.wait(lock, [this] { return !m_pending.empty() || m_closing; });
+        if (m_pending.empty())
+        {
+            // Close() 이후 남은 배치를 모두 기록함
+            break;
+        }
+
+        Batch batch = std::move(m_pending.front());
+        m_pending.pop_front();
+        lock.unlock();
+
+        std::fwrite(batch.data(), sizeof(TraceRecord), batch.size(), m_file);
+        batch.clear();
+
+        lock.lock();
+        m_spare.push_back(std::move(batch));
+        m_wakeup.notify_all();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,186 @@
+#ifndef TRACE_SINK_H
+#define TRACE_SINK_H
+
+#include "trace-record.h"
+
+#include "ns3/nstime.h"
+#include "ns3/simple-ref-count.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Settings of the flight recorder mode of TraceSink.
+ */
+struct FlightRecorderSettings
+{
+    Time history = MilliSeconds(500); //!< Samples kept in memory before a trigger
+    Time after = MilliSeconds(200);   //!< Samples written straight to the file after a trigger
+    double cwndDrop = 0.25;           //!< Relative cwnd reduction that triggers a dump, 0 disables
+    double goodputDrop = 0.5;         //!< Relative goodput drop between bins that triggers a dump, 0 disables
+    bool rto = true;                  //!< Trigger a dump when a socket enters CA_LOSS
+    size_t capacity = 1 << 18;        //!< Records kept in memory at most
+};
+
+/**
+ * \brief Buffered binary sink for simulation traces.
+ *
+ * Trace callbacks append fixed-size TraceRecord entries to an in-memory
+ * batch.  Full batches are handed to a background thread that writes them
+ * to disk, so the simulation never blocks on a flush syscall per sample.
+ * At most a few batches are in flight; if the disk cannot keep up the
+ * producer waits for a batch to be returned instead of growing memory.
+ *
+ * In flight recorder mode (EnableFlightRecorder()) samples only go to a
+ * bounded in-memory ring covering the last FlightRecorderSettings::history.
+ * The sink watches the samples themselves for trigger conditions: a cwnd
+ * reduction or goodput drop beyond the configured fraction, or a socket
+ * entering CA_LOSS (an RTO).  A trigger writes the ring, a TRACE_TRIGGER
+ * record naming the condition and every sample of the following
+ * FlightRecorderSettings::after to the file; triggers within that window
+ * extend it.  Every producer works unchanged, and long runs only write the
+ * few windows around congestion events.  Records stay in time order per
+ * flow; when the ring is full the oldest samples are dropped first, and
+ * samples still in the ring at Close() are discarded.
+ *
+ * The file is always truncated on open, so consecutive runs never mix.
+ * Use the tcp-trace-convert program to turn it into CSV.
+ */
+class TraceSink : public SimpleRefCount<TraceSink>
+{
+public:
+    /**
+     * \brief Open \p filename for writing, truncating any previous content.
+     * \param filename output path
+     * \param batchRecords records per batch handed to the writer thread
+     */
+    TraceSink(const std::string& filename, size_t batchRecords = 1 << 16);
+    ~TraceSink();
+
+    TraceSink(const TraceSink&) = delete;
+    TraceSink& operator=(const TraceSink&) = delete;
+
+    /**
+     * \brief Keep samples in memory and only write them around trigger events.
+     *
+     * Must be called before the first sample is written.
+     *
+     * \param settings history length, triggers and memory bound
+     */
+    void EnableFlightRecorder(const FlightRecorderSettings& settings);
+
+    /**
+     * \brief Record \p value for \p flowId at the current simulation time.
+     * \param flowId compact flow identifier
+     * \param kind what \p value measures
+     * \param value the sample
+     */
+    void Write(uint32_t flowId, TraceKind kind, double value);
+
+    /**
+     * \brief Record \p value for \p flowId at time \p now.
+     * \param now timestamp of the sample
+     * \param flowId compact flow identifier
+     * \param kind what \p value measures
+     * \param value the sample
+     */
+    void Write(Time now, uint32_t flowId, TraceKind kind, double value);
+
+    /**
+     * \brief Write everything recorded so far and close the file.
+     *
+     * Called by the destructor; further writes are ignored.
+     */
+    void Close();
+
+    /**
+     * \return the number of records written to the file so far, trigger
+     *         records included
+     */
+    uint64_t GetRecordCount() const;
+
+    /**
+     * \return the number of samples passed to Write() so far
+     */
+    uint64_t GetSampleCount() const;
+
+    /**
+     * \return the number of flight recorder triggers so far
+     */
+    uint64_t GetTriggerCount() const;
+
+private:
+    typedef std::vector<TraceRecord> Batch;
+
+    /**
+     * Last values of one flow that the flight recorder triggers compare against.
+     */
+    struct FlightFlow
+    {
+        double cwnd;      //!< Last congestion window, negative before the first sample
+        double goodput;   //!< Last goodput bin, negative before the first sample
+        double congState; //!< Last congestion state
+    };
+
+    /**
+     * \brief Append \p record to the active batch.
+     */
+    void Append(const TraceRecord& record);
+
+    /**
+     * \return the FlightTrigger fired by \p record, or 0
+     */
+    uint8_t CheckTrigger(const TraceRecord& record);
+
+    /**
+     * \brief Write the ring and a trigger record and open the post-trigger window.
+     * \param record the sample that fired the trigger
+     * \param trigger the FlightTrigger
+     */
+    void Dump(const TraceRecord& record, uint8_t trigger);
+
+    /**
+     * \brief Hand the active batch to the writer thread and start a new one.
+     */
+    void Submit();
+
+    /**
+     * \brief Writer thread body.
+     */
+    void WriterLoop();
+
+    static const size_t MAX_PENDING_BATCHES = 4; //!< Batches allowed in flight
+
+    std::FILE* m_file;          //!< Output file
+    size_t m_batchRecords;      //!< Records per batch
+    Batch m_active;             //!< Batch being filled by the simulation
+    uint64_t m_recordCount;     //!< Records written so far
+    uint64_t m_sampleCount;     //!< Samples passed to Write()
+
+    bool m_flight;                           //!< True in flight recorder mode
+    FlightRecorderSettings m_flightSettings; //!< Flight recorder settings
+    std::vector<TraceRecord> m_ring;         //!< Samples since the last dump, circular
+    size_t m_ringHead;                       //!< Oldest sample in m_ring
+    size_t m_ringCount;                      //!< Samples in m_ring
+    int64_t m_recordUntilNs;                 //!< End of the post-trigger window
+    std::vector<FlightFlow> m_flightFlows;   //!< Trigger state, indexed by flow id
+    uint64_t m_triggerCount;                 //!< Triggers so far
+
+    std::mutex m_mutex;                //!< Guards the members below
+    std::condition_variable m_wakeup;  //!< Signals pending work or returned batches
+    std::deque<Batch> m_pending;       //!< Batches waiting to be written
+    std::vector<Batch> m_spare;        //!< Written batches ready for reuse
+    bool m_closing;                    //!< Set once Close() has been called
+    std::thread m_writer;              //!< Background writer
+};
+
+} // namespace ns3
+
+#endif // TRACE_SINK_H